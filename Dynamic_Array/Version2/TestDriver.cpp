@@ -26,6 +26,28 @@
 using std::cout;
 using std::endl;
 #include "dynarray.hpp"
+#include "smalldarray.hpp"
+#include "segarray.hpp"
+#include "mappeddarray.hpp"
+#include "simd.hpp"
+#include "par.hpp"
+#include "shareddarray.hpp"
+#include "soadarray.hpp"
+#include "concurrentarray.hpp"
+#include "staticdarray.hpp"
+#include "flatmap.hpp"
+#include "hashmap.hpp"
+#include "radixsort.hpp"
+#include "serialize.hpp"
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <sstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace zh;
 
 unsigned int nPass = 0;
@@ -41,6 +63,63 @@ void CTest1(bool cond, const char* msg){
 }
 
 
+// Passes every request on to new/delete and counts the blocks
+class CountingResource: public MemoryResource{
+    public:
+        size_t allocations = 0;
+
+        void* allocate(size_t bytes, size_t alignment) override{
+            ++allocations;
+            return newDeleteResource()->allocate(bytes, alignment);
+        }
+
+        void deallocate(void* block, size_t bytes, size_t alignment)
+            noexcept override{
+            newDeleteResource()->deallocate(block, bytes, alignment);
+        }
+};
+
+
+// Counts its live objects, the copy that brings the number of
+// copies to failAt throws
+struct ThrowingCopy{
+    static int live;
+    static int copies;
+    static int failAt;
+
+    ThrowingCopy(){ ++live;}
+
+    ThrowingCopy(const ThrowingCopy&){
+        if (++copies == failAt){
+            throw ArrayFull();
+        }
+        ++live;
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    ~ThrowingCopy(){ --live;}
+};
+
+int ThrowingCopy::live = 0;
+int ThrowingCopy::copies = 0;
+int ThrowingCopy::failAt = 0;
+
+
+constexpr StaticDArray<int, 8> squareTable(){
+    StaticDArray<int, 8> table;
+
+    for (int i=0; i < 8; ++i){
+        table.append(i * i);
+    }
+
+    table.remove(0);
+    table.add(-1, 0);
+
+    return table;
+}
+
+
 int main(void)
 {
     DArray<int> testArray1;
@@ -244,6 +323,1368 @@ int main(void)
     CTest1(testArray6[1] == 5, "testArray6, "
             "with value check testing index 1");
 
+    DArray<int> testArray7;
+    testArray7.append(1);
+    testArray7.append(2);
+    testArray7.append(3);
+
+    DArray<int> testArray8 = std::move(testArray7);
+
+    CTest1(testArray8.size() == 3 && testArray8[2] == 3, "testArray8, "
+            "with size() and value check testing move constructor");
+
+    CTest1(testArray7.size() == 0 && testArray7.capacity() == 0,
+            "testArray7, with size() and capacity() check after "
+            "being moved from");
+
+    testArray7 = std::move(testArray8);
+
+    CTest1(testArray7.size() == 3 && testArray7[0] == 1, "testArray7, "
+            "with size() and value check testing move assignment");
+
+    testArray7.append(4);
+
+    CTest1(testArray7.size() == 4 && testArray7[3] == 4, "testArray7, "
+            "with value check testing append() after move assignment");
+
+    DArray< DArray<int> > testArray9;
+    testArray9.emplace_back(3, 7);
+    testArray9.append(DArray<int>(2, 1));
+    testArray9.emplace(0, 1, 9);
+    testArray9.add(DArray<int>(4, 2), 1);
+
+    CTest1(testArray9.size() == 4, "testArray9, "
+            "with size() == 4 check testing emplace() and add()");
+
+    CTest1(testArray9[0].size() == 1 && testArray9[0][0] == 9 &&
+            testArray9[1].size() == 4 && testArray9[1][0] == 2 &&
+            testArray9[2].size() == 3 && testArray9[2][2] == 7 &&
+            testArray9[3].size() == 2 && testArray9[3][1] == 1,
+            "testArray9, with value check testing emplace() and add()");
+
+    for (int i=0; i < 20; ++i){
+        testArray9.emplace_back(testArray9[0]);
+    }
+
+    CTest1(testArray9.size() == 24 && testArray9[23][0] == 9,
+            "testArray9, with value check testing emplace_back() "
+            "of own object during reallocation");
+
+    DArray<int> testArray10;
+    for (int i=0; i < 1000; ++i){
+        testArray10.append(i);
+    }
+
+    CTest1(testArray10.size() == 1000 && testArray10[0] == 0 &&
+            testArray10[999] == 999, "testArray10, with value check "
+            "testing reserve() of trivially copyable objects");
+
+    testArray9.reserve(100);
+
+    CTest1(testArray9.capacity() == 100 && testArray9[1][3] == 2 &&
+            testArray9[23][0] == 9, "testArray9, with value check "
+            "testing reserve() of movable objects");
+
+    int testValues[] = {5, 6, 7, 8};
+    DArray<int> testArray11;
+    testArray11.append(testValues, testValues + 4);
+    testArray11.append_n(3, 9);
+
+    CTest1(testArray11.size() == 7 && testArray11[0] == 5 &&
+            testArray11[3] == 8 && testArray11[6] == 9, "testArray11, "
+            "with value check testing append(first, last) and "
+            "append_n()");
+
+    testArray11.append(testArray10.begin(), testArray10.end());
+
+    CTest1(testArray11.size() == 1007 && testArray11[1006] == 999,
+            "testArray11, with value check testing append(first, last)"
+            " growing the buffer");
+
+    testArray11.append_n(2000, testArray11[0]);
+
+    CTest1(testArray11.size() == 3007 && testArray11[3006] == 5,
+            "testArray11, with value check testing append_n() of own "
+            "object");
+
+    DArray<int, PowerOfTwoGrowth<> > testArray12;
+    testArray12.append_n(9, 1);
+
+    CTest1(testArray12.capacity() == 16, "testArray12, "
+            "with capacity() check testing PowerOfTwoGrowth");
+
+    DArray<int, ChunkGrowth<100> > testArray13(150);
+
+    CTest1(testArray13.capacity() == 200, "testArray13, "
+            "with capacity() check testing ChunkGrowth");
+
+    DArray<int, ExactGrowth> testArray14;
+    testArray14.reserve(3);
+    testArray14.append(1);
+    testArray14.append(2);
+    testArray14.append(3);
+
+    CTest1(testArray14.capacity() == 3, "testArray14, "
+            "with capacity() check testing ExactGrowth");
+
+    DArray<int, GeometricGrowth<2, 1, 1> > testArray15 = testArray14;
+
+    CTest1(testArray15.size() == 3 && testArray15[2] == 3 &&
+            testArray15.capacity() == 6, "testArray15, with value and "
+            "capacity() check converting between growth policies");
+
+    ArenaResource testArena(256);
+    {
+        DArray<int> testArray16(testArena);
+        DArray<int> testArray17(3, 4, testArena);
+
+        for (int i=0; i < 100; ++i){
+            testArray16.append(i);
+        }
+
+        CTest1(testArray16.size() == 100 && testArray16[99] == 99 &&
+                testArray17[2] == 4 && testArray16.resource() == &testArena,
+                "testArray16, with value check testing ArenaResource");
+
+        CTest1(testArena.bytesInUse() > 100 * sizeof(int), "testArena, "
+                "with bytesInUse() check after reallocation");
+
+        DArray<int> testArray18 = testArray16;
+
+        CTest1(testArray18.resource() == newDeleteResource(), 
+                "testArray18, with resource() check testing copy of an "
+                "arena array");
+    }
+
+    testArena.reset();
+
+    CTest1(testArena.bytesInUse() == 0, "testArena, "
+            "with bytesInUse() check after reset()");
+
+    PoolResource testPool;
+    {
+        DArray< DArray<int> > testArray19(testPool);
+
+        for (int i=0; i < 50; ++i){
+            testArray19.append(DArray<int>(i, i, testPool));
+        }
+
+        CTest1(testArray19.size() == 50 && testArray19[49].size() == 49 &&
+                testArray19[49][48] == 49, "testArray19, with value check "
+                "testing PoolResource");
+
+        int* lastHeap = testArray19[49].begin();
+        testArray19.remove_last();
+        testArray19.append(DArray<int>(49, 1, testPool));
+
+        CTest1(testArray19[49].begin() == lastHeap && 
+                testArray19[49][0] == 1, "testArray19, with value check "
+                "testing PoolResource block reuse");
+    }
+
+    SmallDArray<int, 4> testSmall1;
+
+    CTest1(testSmall1.isInline() && testSmall1.capacity() == 4,
+            "testSmall1, with isInline() check testing default "
+            "constructor");
+
+    for (int i=0; i < 4; ++i){
+        testSmall1.append(i);
+    }
+
+    CTest1(testSmall1.isInline() && testSmall1.size() == 4 &&
+            testSmall1[3] == 3, "testSmall1, with isInline() and value "
+            "check after filling the inline storage");
+
+    testSmall1.append(4);
+    testSmall1.add(9, 0);
+
+    CTest1(!testSmall1.isInline() && testSmall1.size() == 6 &&
+            testSmall1[0] == 9 && testSmall1[5] == 4, "testSmall1, with "
+            "isInline() and value check after spilling to the heap");
+
+    {
+        // The 4th copy throws after the array spilled to the heap,
+        // ASan reports a leak if the constructor keeps anything
+        ThrowingCopy::failAt = 4;
+        bool testSmallThrown = false;
+
+        try{
+            SmallDArray<ThrowingCopy, 2> testSmall4(5);
+        }catch (ArrayFull){
+            testSmallThrown = true;
+        }
+
+        CTest1(testSmallThrown && ThrowingCopy::live == 0,
+                "testSmall4, with exception check of a throwing copy "
+                "in the constructor");
+
+        SmallDArray<ThrowingCopy, 2> testSmall5(1);
+        ThrowingCopy::copies = 0;
+        ThrowingCopy::failAt = 3;
+        testSmallThrown = false;
+
+        try{
+            testSmall5.append_n(4, ThrowingCopy());
+        }catch (ArrayFull){
+            testSmallThrown = true;
+        }
+
+        CTest1(testSmallThrown && testSmall5.size() == 1 &&
+                ThrowingCopy::live == 1, "testSmall5, with exception "
+                "check of append_n() appending nothing");
+        ThrowingCopy::failAt = 0;
+    }
+
+    SmallDArray< DArray<int>, 2 > testSmall2;
+    testSmall2.emplace_back(2, 5);
+    SmallDArray< DArray<int>, 2 > testSmall3 = std::move(testSmall2);
+
+    CTest1(testSmall3.isInline() && testSmall3.size() == 1 &&
+            testSmall3[0][1] == 5 && testSmall2.size() == 0, 
+            "testSmall3, with value check testing move constructor of "
+            "inline objects");
+
+    testSmall3.emplace_back(1, 6);
+    testSmall3.emplace_back(1, 7);
+    testSmall2 = std::move(testSmall3);
+
+    CTest1(!testSmall2.isInline() && testSmall2.size() == 3 &&
+            testSmall2[2][0] == 7 && testSmall3.isInline() &&
+            testSmall3.isEmpty(), "testSmall2, with value check testing "
+            "move assignment of a heap");
+
+    testSmall3 = testSmall2;
+    testSmall3.remove(0);
+
+    CTest1(testSmall3.size() == 2 && testSmall3[0][0] == 6 &&
+            testSmall2.size() == 3, "testSmall3, with value check "
+            "testing copy assignment and remove()");
+
+    bool testThrown = false;
+
+    try{
+        testArray1.at(testArray1.size());
+    }catch (InvalidIndexException){
+        testThrown = true;
+    }
+
+    CTest1(testThrown && testArray1.at(1) == 13, "testArray1, "
+            "with exception and value check testing at()");
+
+    testThrown = false;
+
+    try{
+        testSmall3.at(2);
+    }catch (InvalidIndexException){
+        testThrown = true;
+    }
+
+    CTest1(testThrown, "testSmall3, with exception check testing at()");
+
+    SegmentedArray<int, 16> testSegmented1;
+    testSegmented1.append(0);
+    int* firstSegment = &testSegmented1[0];
+
+    for (int i=1; i < 1000; ++i){
+        testSegmented1.append(i);
+    }
+
+    CTest1(testSegmented1.size() == 1000 && testSegmented1[999] == 999 &&
+            &testSegmented1[0] == firstSegment && *firstSegment == 0,
+            "testSegmented1, with value and address check after growth");
+
+    int testSum = 0;
+    for (SegmentedArray<int, 16>::iterator i = testSegmented1.begin(); 
+            i != testSegmented1.end(); ++i){
+        testSum += *i;
+    }
+
+    CTest1(testSum == 499500 && testSegmented1.end() - 
+            testSegmented1.begin() == 1000, "testSegmented1, with sum "
+            "check testing iterators");
+
+    testSegmented1.remove_last();
+    SegmentedArray<int, 16> testSegmented2 = testSegmented1;
+    SegmentedArray<int, 16> testSegmented3 = std::move(testSegmented1);
+
+    CTest1(testSegmented2.size() == 999 && testSegmented2[998] == 998 &&
+            &testSegmented3[0] == firstSegment && 
+            testSegmented1.isEmpty(), "testSegmented2, with value check "
+            "testing copy and move constructor");
+
+    SegmentedArray< DArray<int>, 4 > testSegmented4;
+    for (int i=0; i < 10; ++i){
+        testSegmented4.emplace_back(i, i);
+    }
+    testSegmented4.emplace_back(testSegmented4[9]);
+
+    CTest1(testSegmented4.size() == 11 && testSegmented4[10].size() == 9 &&
+            testSegmented4.capacity() == 12, "testSegmented4, with value "
+            "and capacity() check");
+
+    const char* testMapPath = "/tmp/zh_TestDriver_mapped.bin";
+    std::remove(testMapPath);
+    {
+        MappedDArray<unsigned long> testMapped1(testMapPath);
+
+        for (unsigned long i=0; i < 5000; ++i){
+            testMapped1.append(i * 3);
+        }
+
+        CTest1(testMapped1.size() == 5000 && testMapped1[4999] == 14997 &&
+                testMapped1.capacity() >= 5000, "testMapped1, with value "
+                "check after growing the file");
+    }
+    {
+        MappedDArray<unsigned long> testMapped2(testMapPath, true);
+
+        CTest1(testMapped2.size() == 5000 && testMapped2[1234] == 3702 &&
+                testMapped2.isReadOnly(), "testMapped2, with value check "
+                "after reopening the file read only");
+
+        bool testMapThrown = false;
+
+        try{
+            testMapped2.append(1);
+        }catch (MappingFailed){
+            testMapThrown = true;
+        }
+
+        CTest1(testMapThrown, "testMapped2, with exception check "
+                "testing append() on a read only mapping");
+
+        testMapThrown = false;
+
+        try{
+            testMapped2.at(1234) = 0;
+        }catch (MappingFailed){
+            testMapThrown = true;
+        }
+
+        const MappedDArray<unsigned long>& testMappedView = testMapped2;
+
+        CTest1(testMapThrown && testMappedView.at(1234) == 3702,
+                "testMapped2, with exception check testing the writable "
+                "at() on a read only mapping");
+
+        testMapThrown = false;
+
+        try{
+            MappedDArray<int> testMapped3(testMapPath);
+        }catch (FormatMismatch){
+            testMapThrown = true;
+        }
+
+        CTest1(testMapThrown, "testMapped3, with exception check "
+                "opening a file of a different object size");
+    }
+    std::remove(testMapPath);
+
+    {
+        // Every instruction set must agree with a plain loop, 37
+        // objects leave a tail for every register width
+        DArray<int> testSimd1;
+        DArray<float> testSimd2;
+        DArray<double> testSimd3;
+        DArray<int> testSimdOut(37);
+        int testExpected = 0;
+        long long testDot = 0;
+
+        for (int i=0; i < 37; ++i){
+            testSimd1.append((i * 7) % 23 - 11);
+            testSimd2.append(float(i % 5));
+            testSimd3.append(i * 0.5);
+            testExpected += (i * 7) % 23 - 11;
+            testDot += ((i * 7) % 23 - 11) * ((i * 7) % 23 - 11);
+        }
+
+        bool testAgree = true;
+        simd::Isa testBest = simd::detectIsa();
+
+        for (int isa = simd::SCALAR; isa <= testBest; ++isa){
+            simd::setIsa(simd::Isa(isa));
+            const int* first = testSimd1.begin();
+            const int* last = testSimd1.end();
+
+            testAgree = testAgree && simd::sum(first, last) == testExpected
+                && simd::min(first, last) == -11
+                && simd::max(first, last) == 11
+                && simd::dot(first, last, first) == testDot
+                && simd::count(first, last, -4) == 2
+                && simd::find(first, last, 10) == first + 3
+                && simd::find(first, last, 99) == last
+                && simd::sum(testSimd2.begin(), testSimd2.end()) == 71.0f
+                && simd::count(testSimd2.begin(), testSimd2.end(),
+                        4.0f) == 7
+                && simd::max(testSimd3.begin(), testSimd3.end()) == 18.0
+                && simd::sum(testSimd3.begin(), testSimd3.end()) == 333.0;
+
+            simd::transform(first, last, first, testSimdOut.begin(),
+                    simd::Multiplies());
+            testAgree = testAgree && testSimdOut[36] ==
+                testSimd1[36] * testSimd1[36];
+
+            simd::fill(testSimdOut.begin() + 1, testSimdOut.end(), 9);
+            testAgree = testAgree && testSimdOut[0] == 121 &&
+                simd::count(testSimdOut.begin(), testSimdOut.end(), 9) == 36;
+        }
+        simd::setIsa(testBest);
+
+        CTest1(testAgree, "testSimd1, every instruction set matching "
+                "the plain loop");
+
+        bool testThrown = false;
+        try{
+            simd::min(testSimd1.begin(), testSimd1.begin());
+        }catch (ArrayEmpty){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testSimd1, with exception check min() "
+                "of an empty range");
+    }
+
+    {
+        DArray<int> testArray20;
+        int testRange[] = {100, 101, 102};
+
+        for (int i=0; i < 6; ++i){
+            testArray20.append(i);
+        }
+
+        // Range shorter than the tail, then longer than the tail
+        testArray20.insert(2, testRange, testRange + 3);
+        testArray20.insert(8, testRange, testRange + 3);
+        CTest1(testArray20.size() == 12 && testArray20[1] == 1 &&
+                testArray20[2] == 100 && testArray20[4] == 102 &&
+                testArray20[5] == 2 && testArray20[8] == 100 &&
+                testArray20[10] == 102 && testArray20[11] == 5,
+                "testArray20, insert() of a range in the middle");
+
+        testArray20.insert(0, 2, testArray20[11]);
+        testArray20.insert(testArray20.size(), 1, -1);
+        CTest1(testArray20.size() == 15 && testArray20[0] == 5 &&
+                testArray20[1] == 5 && testArray20[2] == 0 &&
+                testArray20[14] == -1,
+                "testArray20, insert() of copies of its own object");
+
+        testArray20.erase(2, 7);
+        CTest1(testArray20.size() == 10 && testArray20[1] == 5 &&
+                testArray20[2] == 2 && testArray20[9] == -1,
+                "testArray20, erase() of a range");
+
+        size_t testErased = testArray20.erase_if([](const int& x){
+                return x >= 100;});
+        CTest1(testErased == 3 && testArray20.size() == 7 &&
+                testArray20[2] == 2 && testArray20[3] == 3 &&
+                testArray20[6] == -1,
+                "testArray20, erase_if() keeping the order");
+
+        bool testThrown = false;
+        try{
+            testArray20.erase(5, 8);
+        }catch (InvalidIndexException){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testArray20, with exception check erase() "
+                "past the end");
+
+        DArray<DArray<int> > testNested;
+        testNested.append(testArray20);
+        testNested.append(DArray<int>(3, 9));
+        DArray<DArray<int> > testNestedItems(2, DArray<int>(1, 4));
+        testNested.insert(1, testNestedItems.begin(),
+                testNestedItems.end());
+        testNested.remove(0);
+        CTest1(testNested.size() == 3 && testNested[0][0] == 4 &&
+                testNested[2].size() == 3 && testNested[2][2] == 9,
+                "testNested, insert() and remove() of objects owning "
+                "memory");
+    }
+
+    {
+        DArray<int> testArray21;
+        for (int i=0; i < 1000; ++i){
+            testArray21.append(i);
+        }
+
+        testArray21.resize(10);
+        bool testKept = testArray21.capacity() >= 1000;
+        testArray21.shrink_to_fit();
+        CTest1(testKept && testArray21.capacity() == 10 &&
+                testArray21[9] == 9,
+                "testArray21, shrink_to_fit() after resize() down");
+
+        testArray21.reserve(100);
+        bool testTrimmed = testArray21.trim(0.25);
+        CTest1(testTrimmed && testArray21.capacity() == 15 &&
+                !testArray21.trim(0.25) && testArray21[0] == 0,
+                "testArray21, trim() below a utilization ratio");
+
+        testArray21.clear();
+        testArray21.shrink_to_fit();
+        testArray21.append(7);
+        CTest1(testArray21.capacity() == 5 && testArray21[0] == 7,
+                "testArray21, growing again after giving its heap back");
+
+        DArray<int, AutoShrink<> > testShrinking;
+        for (int i=0; i < 1000; ++i){
+            testShrinking.append(i);
+        }
+        size_t testPeak = testShrinking.capacity();
+
+        testShrinking.erase(100, 1000);
+        size_t testAfterErase = testShrinking.capacity();
+        testShrinking.erase_if([](const int& x){ return x % 2 == 1;});
+        size_t testAfterFilter = testShrinking.capacity();
+
+        // 50 of 150 objects is above the ratio, the heap stays
+        testShrinking.remove_last();
+        CTest1(testPeak >= 1000 && testAfterErase == 150 &&
+                testAfterFilter == 150 && 
+                testShrinking.capacity() == 150 &&
+                testShrinking[48] == 96,
+                "testShrinking, AutoShrink policy with hysteresis");
+
+        testShrinking.clear();
+        CTest1(testShrinking.capacity() == 5,
+                "testShrinking, clear() giving memory back");
+
+        // Destroying or assigning over an AutoShrink array gives its
+        // heap back without building a smaller one first
+        CountingResource testCounter;
+        {
+            DArray<int, AutoShrink<> > testShrink1(testCounter);
+            DArray<int, AutoShrink<> > testShrink2(testCounter);
+            for (int i=0; i < 1000; ++i){
+                testShrink1.append(i);
+                testShrink2.append(i);
+            }
+
+            testCounter.allocations = 0;
+            testShrink1 = std::move(testShrink2);
+        }
+        CTest1(testCounter.allocations == 0,
+                "testShrink1, with allocation check of the destructor "
+                "and move assignment");
+    }
+
+    {
+        DArray<int> testNarrow;
+        DArray<double> testWide;
+        for (int i=0; i < 1001; ++i){
+            testNarrow.append(i - 500);
+            testWide.append(i * 0.75);
+        }
+
+        DArray<long long> testWidened(testNarrow);
+        DArray<int> testTruncated(testWide);
+        CTest1(testWidened.size() == 1001 && testWidened[0] == -500 &&
+                testWidened[1000] == 500 && testTruncated[3] == 2 &&
+                testTruncated[1000] == 750,
+                "testWidened, converting constructor between arithmetic "
+                "types");
+
+        DArray<DArray<int> > testSized(DArray<size_t>(3, 4));
+        CTest1(testSized.size() == 3 && testSized[2].size() == 4,
+                "testSized, converting constructor building objects "
+                "directly from the source objects");
+    }
+
+    {
+        DArray<int> testSource;
+        for (int i=0; i < 100; ++i){
+            testSource.append(i);
+        }
+
+        SharedDArray<int> testShared1(std::move(testSource));
+        SharedDArray<int> testShared2 = testShared1;
+        SharedDArray<int> testShared3;
+        testShared3 = testShared2;
+
+        CTest1(testShared1.useCount() == 3 &&
+                testShared2.begin() == testShared1.begin() &&
+                testShared3[99] == 99,
+                "testShared1, copies sharing one buffer");
+
+        testShared2.set(0, -1);
+        testShared3.append(100);
+        CTest1(testShared1[0] == 0 && testShared1.size() == 100 &&
+                testShared2[0] == -1 && testShared3.size() == 101 &&
+                testShared1.isUnique() && testShared2.isUnique() &&
+                testShared2.begin() != testShared1.begin(),
+                "testShared2, copy on the first modification");
+
+        const int* testBefore = testShared1.begin();
+        testShared1.write()[5] = 50;
+        CTest1(testShared1.begin() == testBefore && testShared1[5] == 50,
+                "testShared1, no copy when modifying the only handle");
+
+        SharedDArray<int> testShared4(std::move(testShared1));
+        CTest1(testShared1.isEmpty() && testShared4.size() == 100 &&
+                testShared4[5] == 50,
+                "testShared4, move leaving an empty handle");
+
+        bool testThrown = false;
+        try{
+            testShared4.set(100, 0);
+        }catch (InvalidIndexException){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testShared4, with exception check set() "
+                "past the end");
+    }
+
+    {
+        SoADArray<int, double, char> testRecords;
+        for (int i=0; i < 50; ++i){
+            testRecords.append(i, i * 0.5, char('a' + i % 26));
+        }
+
+        ColumnSpan<double> testColumn = testRecords.column<1>();
+        CTest1(testRecords.size() == 50 && testColumn.size() == 50 &&
+                testColumn[49] == 24.5 &&
+                simd::sum(testColumn.begin(), testColumn.end()) == 612.5 &&
+                testRecords[27].get<2>() == 'b',
+                "testRecords, appending records and reading a column");
+
+        testRecords[3].get<0>() = 300;
+        testRecords.at(4).assign(400, -1.0, 'z');
+        testRecords.remove(0);
+        std::tuple<int, double, char> testRow = testRecords[3].value();
+        CTest1(testRecords.size() == 49 && 
+                testRecords[2].get<0>() == 300 &&
+                std::get<0>(testRow) == 400 && std::get<1>(testRow) == -1.0 &&
+                std::get<2>(testRow) == 'z' &&
+                testRecords.column<2>()[48] == 'x',
+                "testRecords, row proxies and remove() of a record");
+
+        testRecords.resize(60);
+        const SoADArray<int, double, char>& testView = testRecords;
+        CTest1(testView.column<0>()[59] == 0 && testView[59].get<2>() == 0 &&
+                testView.column<1>().size() == 60,
+                "testRecords, resize() adding value initialized records");
+
+        bool testThrown = false;
+        try{
+            testView.at(60);
+        }catch (InvalidIndexException){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testRecords, with exception check at() "
+                "past the end");
+    }
+
+    {
+        DArray<bool> testBits1;
+        for (int i=0; i < 200; ++i){
+            testBits1.append(i % 3 == 0);
+        }
+
+        CTest1(testBits1.size() == 200 && testBits1.wordCount() == 4 &&
+                testBits1.count() == 67 && testBits1[99] && !testBits1[100],
+                "testBits1, 64 flags per word with count()");
+
+        testBits1[100] = true;
+        testBits1[0] = testBits1[1];
+        testBits1.at(3).flip();
+        CTest1(testBits1[100] && !testBits1[0] && !testBits1[3] &&
+                testBits1.find_first() == 6 && testBits1.find_next(99) == 100 &&
+                testBits1.find_next(198) == 200,
+                "testBits1, proxy references and find_first()");
+
+        DArray<bool> testBits2(200, true);
+        testBits2.resize(260, true);
+        testBits2.append_word(0x5, 3);
+        testBits2.append_word(~0ULL);
+        CTest1(testBits2.size() == 327 && testBits2.count() == 326 &&
+                !testBits2[261] && testBits2[326],
+                "testBits2, resize() and append_word() across words");
+
+        testBits2 ^= testBits1;
+        testBits2.flip();
+        testBits2 &= testBits1;
+        CTest1(testBits2.count() == testBits1.count() &&
+                testBits2[100] && testBits2.size() == 327,
+                "testBits2, bitwise operators between arrays");
+
+        testBits2.remove_last();
+        testBits2.flip();
+        CTest1(testBits2.size() == 326 &&
+                testBits2.count() == 326 - testBits1.count(),
+                "testBits2, flip() keeping the bits past size() clear");
+
+        bool testThrown = false;
+        try{
+            testBits1.append_word(0, 65);
+        }catch (InvalidIndexException){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testBits1, with exception check append_word() "
+                "of more than 64 flags");
+    }
+
+    {
+        // Small segments so the producers race for new ones
+        ConcurrentAppendArray<long long, 16> testConcurrent;
+        DArray<std::thread> testProducers;
+        std::atomic<bool> testOrdered(true);
+
+        for (int t=0; t < 4; ++t){
+            testProducers.append(std::thread([&testConcurrent, t](){
+                        for (long long i=0; i < 20000; ++i){
+                            testConcurrent.append(i * 4 + t);
+                        }
+                    }));
+        }
+
+        // Reads while the producers append, every published object
+        // must be complete
+        testProducers.append(std::thread([&testConcurrent, &testOrdered](){
+                    size_t seen = 0;
+                    while (seen < 80000){
+                        size_t now = testConcurrent.size();
+                        for (; seen < now; ++seen){
+                            if (testConcurrent[seen] < 0 ||
+                                    testConcurrent[seen] >= 80000){
+                                testOrdered = false;
+                            }
+                        }
+                    }
+                }));
+
+        for (size_t i=0; i < testProducers.size(); ++i){
+            testProducers[i].join();
+        }
+
+        DArray<bool> testSeen(80000);
+        for (size_t i=0; i < testConcurrent.size(); ++i){
+            testSeen[testConcurrent.at(i)] = true;
+        }
+
+        CTest1(testConcurrent.size() == 80000 && testSeen.count() == 80000 &&
+                testOrdered,
+                "testConcurrent, 4 threads appending while one reads");
+
+        bool testThrown = false;
+        try{
+            testConcurrent.at(80000);
+        }catch (InvalidIndexException){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testConcurrent, with exception check at() "
+                "past the published size");
+    }
+
+    {
+        DArray<float> testAligned(*alignedResource<64>());
+
+        for (int i=0; i < 1000; ++i){
+            testAligned.append(i);
+        }
+
+        CTest1(reinterpret_cast<std::uintptr_t>(testAligned.begin()) % 64
+                == 0 && testAligned[999] == 999, "testAligned, with "
+                "alignment check after growth on an AlignedResource");
+
+        // A threshold of one page maps the large array and leaves
+        // the small one to the upstream resource
+        HugePageResource testHuge(4096);
+        DArray<double> testHugeArray(testHuge);
+        DArray<char> testHugeSmall(testHuge);
+
+        testHugeArray.resize(300000, 1.5);
+        testHugeSmall.append('a');
+
+        CTest1(reinterpret_cast<std::uintptr_t>(testHugeArray.begin()) %
+                HugePageResource::HUGE_PAGE == 0 &&
+                testHugeArray[299999] == 1.5 && testHugeSmall[0] == 'a',
+                "testHugeArray, with alignment and value check testing "
+                "HugePageResource");
+    }
+
+    {
+        typedef DArray<short, ExactGrowth> Counted;
+        instrument::reset<Counted>();
+
+        {
+            Counted testCounted;
+
+            for (short i=0; i < 8; ++i){
+                testCounted.append(i);
+            }
+
+            Counted testCountedCopy = testCounted;
+        }
+
+        instrument::Snapshot testCounts = instrument::snapshot<Counted>();
+
+#if ZH_INSTRUMENT
+        CTest1(testCounts.allocations == testCounts.deallocations &&
+                testCounts.bytesAllocated == testCounts.bytesReleased &&
+                testCounts.reallocations > 0 && testCounts.moves > 0 &&
+                testCounts.copies == 8 && testCounts.peakCapacity >= 8,
+                "testCounts, with counter check testing instrumentation");
+#else
+        CTest1(testCounts.allocations == 0 && testCounts.copies == 0,
+                "testCounts, with counter check testing instrumentation "
+                "compiled out");
+#endif
+    }
+
+    {
+        constexpr StaticDArray<int, 8> testStatic1 = squareTable();
+        static_assert(testStatic1.size() == 8 && testStatic1[7] == 49,
+                "squareTable() is built at compile time");
+
+        CTest1(testStatic1[0] == -1 && testStatic1[1] == 1 &&
+                testStatic1.isFull() && sizeof(testStatic1) ==
+                8 * sizeof(int) + sizeof(size_t), "testStatic1, with "
+                "value and size check of a compile time table");
+
+        StaticDArray<DArray<int>, 3> testStatic2;
+        testStatic2.append(DArray<int>(2, 7));
+        testStatic2.emplace_back(3, 8);
+        testStatic2.add(DArray<int>(1, 9), 1);
+        testStatic2.remove(0);
+
+        bool testThrown = false;
+        try{
+            testStatic2.append(DArray<int>());
+            testStatic2.append(DArray<int>());
+        }catch (ArrayFull){
+            testThrown = true;
+        }
+
+        CTest1(testThrown && testStatic2.size() == 3 &&
+                testStatic2[0][0] == 9 && testStatic2[1].size() == 3 &&
+                testStatic2[1][2] == 8, "testStatic2, with value and "
+                "exception check of objects owning memory");
+    }
+
+    {
+        int testKeys[] = {9, 3, 7, 3, 1, 9, 5};
+        FlatSet<int> testSet1(testKeys, testKeys + 7);
+
+        CTest1(testSet1.size() == 5 && testSet1.begin()[0] == 1 &&
+                testSet1.begin()[4] == 9 && testSet1.contains(7) &&
+                !testSet1.contains(4), "testSet1, with value check "
+                "building from unsorted keys with duplicates");
+
+        int testMore[] = {4, 9, 2, 4};
+        size_t testAdded = testSet1.insert(testMore, testMore + 4);
+
+        CTest1(testAdded == 2 && !testSet1.insert(5) &&
+                testSet1.insert(6) && testSet1.erase(1) &&
+                !testSet1.erase(1) && testSet1.size() == 7 &&
+                *testSet1.lower_bound(8) == 9, "testSet1, with value "
+                "check after batched and single changes");
+
+        DArray<int> testOdd;
+
+        for (int i=0; i < 1000; ++i){
+            testOdd.append(2 * ((i * 7919) % 1000) + 1);
+        }
+
+        FlatSet<int> testSet2(testOdd.begin(), testOdd.end());
+        bool testSame = true;
+
+        for (int pass=0; pass < 2; ++pass){
+            for (int i=-1; i < 2002; ++i){
+                const int* found = testSet2.find(i);
+                testSame = testSame && (i % 2 != 0 && i > 0 && i < 2000 ?
+                        found != testSet2.end() && *found == i :
+                        found == testSet2.end()) &&
+                    testSet2.lower_bound(i) - testSet2.begin() ==
+                    (i <= 0 ? 0 : i / 2);
+            }
+
+            testSet2.buildIndex();
+        }
+
+        CTest1(testSame && testSet2.hasIndex(), "testSet2, with find() "
+                "and lower_bound() check with and without the "
+                "Eytzinger index");
+
+        testSet2.insert(0);
+
+        CTest1(!testSet2.hasIndex() && testSet2.contains(0),
+                "testSet2, with hasIndex() check after a change");
+
+        std::pair<int, const char*> testPairs[] = {
+            std::make_pair(3, "c"), std::make_pair(1, "a"),
+            std::make_pair(3, "x"), std::make_pair(2, "b")};
+        FlatMap<int, const char*> testMap1(testPairs, testPairs + 4);
+
+        CTest1(testMap1.size() == 3 && testMap1.keyAt(0) == 1 &&
+                testMap1.at(3)[0] == 'c' && *testMap1.find(2)[0] == 'b' &&
+                testMap1.find(4) == nullptr, "testMap1, with value check "
+                "building from unsorted pairs, the first pair wins");
+
+        std::pair<int, const char*> testMorePairs[] = {
+            std::make_pair(5, "e"), std::make_pair(1, "z"),
+            std::make_pair(0, "o")};
+        testAdded = testMap1.insert(testMorePairs, testMorePairs + 3);
+        testMap1[4] = "d";
+        testMap1.buildIndex();
+
+        bool testThrown = false;
+        try{
+            testMap1.at(7);
+        }catch (KeyNotFound){
+            testThrown = true;
+        }
+
+        CTest1(testAdded == 2 && testMap1.size() == 6 &&
+                testMap1.at(1)[0] == 'a' && testMap1.keyAt(0) == 0 &&
+                testMap1.valueAt(5)[0] == 'e' && testMap1[4][0] == 'd' &&
+                testMap1.erase(2) && !testMap1.contains(2) && testThrown,
+                "testMap1, with value and exception check after merging "
+                "a batch");
+
+        // bool values can't live in the bit packed DArray<bool>
+        std::pair<int, bool> testFlagPairs[] = {
+            std::make_pair(2, true), std::make_pair(1, false)};
+        FlatMap<int, bool> testFlags(testFlagPairs, testFlagPairs + 2);
+        testFlags[3] = true;
+        testFlags.insert(0, true);
+        *testFlags.find(1) = true;
+        testFlags.at(2) = false;
+        testFlags.erase(0);
+        FlatMap<int, bool>::value_pointer testFlag = testFlags.find(3);
+
+        CTest1(testFlags.size() == 3 && testFlags.at(1) &&
+                !testFlags.valueAt(1) && testFlags[3] && *testFlag &&
+                testFlags.values()[2] && std::is_same<FlatMap<int,
+                int>::value_reference, int&>::value, "testFlags, with "
+                "value check of a map to bool");
+    }
+
+    {
+        HashMap<int, int> testHash1;
+        DArray<int> testShadow(5000, -1);
+        bool testSame = true;
+
+        // Inserts, erases and reinserts, checked against a plain
+        // array indexed by key
+        for (int i=0; i < 20000; ++i){
+            int key = (i * 7919) % 5000;
+
+            if (i % 3 == 2){
+                testSame = testSame &&
+                    testHash1.erase(key) == (testShadow[key] != -1);
+                testShadow[key] = -1;
+            }else{
+                testHash1[key] = i;
+                testShadow[key] = i;
+            }
+        }
+
+        size_t testFull = 0;
+
+        for (int key=0; key < 5000; ++key){
+            const int* found = testHash1.find(key);
+            testSame = testSame && (testShadow[key] == -1 ?
+                    found == nullptr : found != nullptr &&
+                    *found == testShadow[key]);
+            testFull += (testShadow[key] != -1);
+        }
+
+        size_t testVisited = 0;
+
+        for (HashMap<int, int>::const_iterator i = testHash1.begin();
+                i != testHash1.end(); ++i){
+            testSame = testSame && testShadow[i->first] == i->second;
+            ++testVisited;
+        }
+
+        CTest1(testSame && testVisited == testFull &&
+                testHash1.size() == testFull && !testHash1.contains(5001),
+                "testHash1, with erase(), find() and iteration check "
+                "against a plain array");
+
+        HashMap<int, int> testHash2 = testHash1;
+        testHash1.clear();
+
+        bool testThrown = false;
+        try{
+            testHash1.at(0);
+        }catch (KeyNotFound){
+            testThrown = true;
+        }
+
+        CTest1(testThrown && testHash1.isEmpty() &&
+                testHash2.size() == testFull && !testHash2.insert(
+                    testHash2.begin()->first, 0), "testHash2, with "
+                "size() check of a copy and at() exception check");
+
+        HashMap<std::string, int> testWords;
+        testWords.reserve(100);
+        size_t testSlots = testWords.capacity();
+        const char* testNames[] = {"alpha", "beta", "gamma",
+            "a longer key than eight bytes", "beta"};
+
+        for (int i=0; i < 5; ++i){
+            testWords[testNames[i]] += i + 1;
+        }
+
+        CTest1(testWords.size() == 4 && testWords.at("beta") == 7 &&
+                testWords.at("a longer key than eight bytes") == 4 &&
+                testWords.capacity() == testSlots && testSlots >= 100,
+                "testWords, with value check of text keys");
+
+        HashMap<int, std::string> testAlias;
+        std::string testLong(40, 'z');
+        testAlias.insert(0, testLong);
+        size_t testGrown = 0;
+        bool testKept = true;
+
+        // Some of these inserts rehash while the value still points
+        // into the map
+        for (int i=1; i < 100; ++i){
+            size_t testBefore = testAlias.capacity();
+            testAlias.insert(i, testAlias.at(i - 1));
+            testGrown += testAlias.capacity() != testBefore;
+            testKept = testKept && testAlias.at(i) == testLong;
+        }
+
+        CTest1(testKept && testGrown > 0 && testAlias.size() == 100,
+                "testAlias, with value check of inserts that copy an "
+                "entry of the map through a rehash");
+    }
+
+    {
+        DArray<uint32_t> testRadix1;
+        uint32_t testSeed = 12345;
+
+        for (int i=0; i < 5000; ++i){
+            testSeed = testSeed * 1103515245u + 12345u;
+            testRadix1.append(testSeed);
+        }
+
+        DArray<uint32_t> testSorted(testRadix1);
+        std::sort(testSorted.begin(), testSorted.end());
+        radix_sort(testRadix1);
+
+        CTest1(std::equal(testRadix1.begin(), testRadix1.end(),
+                    testSorted.begin()),
+                "testRadix1, with value check against std::sort");
+
+        DArray<int> testRadix2;
+        int testSigned[] = {5, -3, 700000, -700000, 0, -1, 1, 42};
+
+        for (int i=0; i < 8; ++i){
+            testRadix2.append(testSigned[i]);
+        }
+
+        radix_sort(testRadix2);
+
+        CTest1(std::is_sorted(testRadix2.begin(), testRadix2.end()) &&
+                testRadix2[0] == -700000 && testRadix2[7] == 700000,
+                "testRadix2, with value check of negative integers");
+
+        DArray<double> testRadix3;
+        double testReals[] = {2.5, -0.5, -100.25, 0.0, 1e10, -1e-3};
+
+        for (int i=0; i < 6; ++i){
+            testRadix3.append(testReals[i]);
+        }
+
+        radix_sort(testRadix3);
+
+        CTest1(std::is_sorted(testRadix3.begin(), testRadix3.end()) &&
+                testRadix3[0] == -100.25 && testRadix3[5] == 1e10,
+                "testRadix3, with value check of negative doubles");
+
+        // Records sorted by the first, the second keeps the order
+        // they were appended in
+        DArray<std::pair<short, int> > testRecords;
+
+        for (int i=0; i < 300; ++i){
+            testRecords.append(std::make_pair(
+                        static_cast<short>((i * 7) % 13 - 6), i));
+        }
+
+        DArray<std::pair<short, int> > testCounted(testRecords);
+        auto testKey = [](const std::pair<short, int>& record){
+            return record.first;
+        };
+
+        radix_sort(testRecords, testKey);
+        counting_sort(testCounted, testKey);
+
+        bool testStable = true;
+
+        for (size_t i=1; i < testRecords.size(); ++i){
+            testStable = testStable &&
+                (testRecords[i-1].first < testRecords[i].first ||
+                 (testRecords[i-1].first == testRecords[i].first &&
+                  testRecords[i-1].second < testRecords[i].second));
+        }
+
+        CTest1(testStable && std::equal(testRecords.begin(),
+                    testRecords.end(), testCounted.begin()),
+                "testRecords, with value check of a stable key sort");
+
+        DArray<char> testCount1;
+        const char* testText = "counting sort";
+
+        for (const char* c = testText; *c != '\0'; ++c){
+            testCount1.append(*c);
+        }
+
+        counting_sort(testCount1);
+
+        CTest1(testCount1.size() == 13 && testCount1[0] == ' ' &&
+                testCount1[12] == 'u' && std::is_sorted(testCount1.begin(),
+                    testCount1.end()),
+                "testCount1, with value check of a small key range");
+
+        // A range far wider than the array falls back to radix_sort
+        DArray<long long> testCount2;
+        long long testWide[] = {1LL << 40, -(1LL << 50), 3, 1LL << 62, -7};
+
+        for (int i=0; i < 5; ++i){
+            testCount2.append(testWide[i]);
+        }
+
+        counting_sort(testCount2);
+
+        CTest1(std::is_sorted(testCount2.begin(), testCount2.end()) &&
+                testCount2[0] == -(1LL << 50) && testCount2[4] == 1LL << 62,
+                "testCount2, with value check of a wide key range");
+    }
+
+    {
+        DArray<double> testSave1;
+        DArray<std::string> testSave2;
+        DArray<DArray<int> > testSave3(3);
+
+        for (int i=0; i < 1000; ++i){
+            testSave1.append(i * 0.25);
+        }
+
+        testSave2.append("alpha");
+        testSave2.append("");
+        testSave2.append("a string longer than one word");
+
+        testSave3[0].append(7);
+        testSave3[2].append(8);
+        testSave3[2].append(9);
+
+        // Three arrays one after the other in the same stream
+        std::stringstream testStream;
+        save(testSave1, testStream);
+        save(testSave2, testStream);
+        save(testSave3, testStream);
+
+        DArray<double> testLoad1(5, 1.0);
+        DArray<std::string> testLoad2;
+        DArray<DArray<int> > testLoad3;
+        load(testLoad1, testStream);
+        load(testLoad2, testStream);
+        load(testLoad3, testStream);
+
+        CTest1(testLoad1.size() == 1000 && testLoad1[999] == 249.75 &&
+                std::equal(testLoad1.begin(), testLoad1.end(),
+                    testSave1.begin()), "testLoad1, with value check of "
+                "trivially copyable objects");
+
+        CTest1(testLoad2.size() == 3 && testLoad2[0] == "alpha" &&
+                testLoad2[1].empty() &&
+                testLoad2[2] == "a string longer than one word",
+                "testLoad2, with value check of text objects");
+
+        CTest1(testLoad3.size() == 3 && testLoad3[0].size() == 1 &&
+                testLoad3[1].isEmpty() && testLoad3[2].size() == 2 &&
+                testLoad3[2][1] == 9, "testLoad3, with value check of "
+                "nested arrays");
+
+        // A flipped byte of the payload fails the checksum and
+        // leaves the array as it was
+        std::string testBytes;
+        {
+            std::stringstream testOut;
+            save(testSave1, testOut);
+            testBytes = testOut.str();
+        }
+        testBytes[100] ^= 1;
+
+        std::stringstream testDamaged(testBytes);
+        bool testSaveThrown = false;
+
+        try{
+            load(testLoad1, testDamaged);
+        }catch (FormatMismatch){
+            testSaveThrown = true;
+        }
+
+        CTest1(testSaveThrown && testLoad1.size() == 1000,
+                "testDamaged, with exception check of a wrong checksum");
+
+        testSaveThrown = false;
+        std::stringstream testOther(testBytes);
+        DArray<float> testFloats;
+
+        try{
+            load(testFloats, testOther);
+        }catch (FormatMismatch){
+            testSaveThrown = true;
+        }
+
+        CTest1(testSaveThrown, "testFloats, with exception check "
+                "loading objects of a different size");
+
+        testSaveThrown = false;
+        std::stringstream testShort(testBytes.substr(0, 500));
+
+        try{
+            load(testLoad1, testShort);
+        }catch (StreamFailure){
+            testSaveThrown = true;
+        }
+
+        CTest1(testSaveThrown, "testShort, with exception check "
+                "loading a truncated array");
+    }
+
+    {
+        const char* testFilePath = "/tmp/zh_TestDriver_serialized.bin";
+        DArray<unsigned int> testWrite1;
+        DArray<std::string> testWrite2;
+
+        for (unsigned int i=0; i < 100000; ++i){
+            testWrite1.append(i * 2654435761u);
+        }
+
+        testWrite2.append("first");
+        testWrite2.append("second");
+
+        int testFd = ::open(testFilePath, O_WRONLY | O_CREAT | O_TRUNC,
+                0600);
+        write_to(testWrite1, testFd);
+        write_to(testWrite2, testFd);
+        ::close(testFd);
+
+        DArray<unsigned int> testRead1;
+        DArray<std::string> testRead2;
+        testFd = ::open(testFilePath, O_RDONLY);
+        read_from(testRead1, testFd);
+        read_from(testRead2, testFd);
+
+        bool testEnded = false;
+
+        try{
+            read_from(testRead1, testFd);
+        }catch (StreamFailure){
+            testEnded = true;
+        }
+
+        ::close(testFd);
+        std::remove(testFilePath);
+
+        CTest1(testRead1.size() == 100000 && std::equal(testRead1.begin(),
+                    testRead1.end(), testWrite1.begin()) &&
+                testRead2.size() == 2 && testRead2[1] == "second" &&
+                testEnded, "testRead1, with value check of write_to() "
+                "and read_from() up to the end of the file");
+    }
+
+    {
+        // A low threshold and a pool of 4 threads split these small
+        // arrays whatever the number of processors
+        size_t testOldThreshold = par::serialThreshold();
+        par::ThreadPool& testOldPool = par::defaultPool();
+        par::ThreadPool testPool(4);
+        par::setSerialThreshold(1000);
+        par::usePool(testPool);
+
+        DArray<long long> testPar1;
+        DArray<long long> testPar2(100003);
+        unsigned testSeed = 12345;
+
+        for (int i=0; i < 100003; ++i){
+            testSeed = testSeed * 1103515245u + 12345u;
+            testPar1.append(static_cast<long long>(testSeed >> 8) % 50000);
+        }
+
+        DArray<long long> testSorted(testPar1);
+        std::sort(testSorted.begin(), testSorted.end());
+
+        long long testTotal = 0;
+        for (size_t i=0; i < testPar1.size(); ++i){
+            testTotal += testPar1[i];
+        }
+
+        CTest1(par::reduce(testPar1.begin(), testPar1.end(), 7LL,
+                    std::plus<long long>()) == testTotal + 7,
+                "testPar1, reduce() matching a serial sum");
+
+        par::inclusive_scan(testPar1.begin(), testPar1.end(),
+                testPar2.begin(), std::plus<long long>());
+        CTest1(testPar2[0] == testPar1[0] &&
+                testPar2[50000] - testPar2[49999] == testPar1[50000] &&
+                testPar2[100002] == testTotal,
+                "testPar2, inclusive_scan() of testPar1");
+
+        par::transform(testPar1.begin(), testPar1.end(), testPar2.begin(),
+                [](long long x){ return x * 2;});
+        par::for_each(testPar2.begin(), testPar2.end(),
+                [](long long& x){ x += 1;});
+        CTest1(testPar2[777] == testPar1[777] * 2 + 1 &&
+                testPar2[100002] == testPar1[100002] * 2 + 1,
+                "testPar2, transform() then for_each() over testPar1");
+
+        par::sort(testPar1.begin(), testPar1.end());
+        CTest1(std::equal(testPar1.begin(), testPar1.end(),
+                    testSorted.begin()),
+                "testPar1, sort() matching std::sort");
+
+        DArray<int> testDescending;
+        for (int i=0; i < 5000; ++i){
+            testDescending.append(i % 97);
+        }
+        par::sort(testDescending.begin(), testDescending.end(),
+                std::greater<int>());
+        CTest1(testDescending[0] == 96 && testDescending[4999] == 0 &&
+                std::is_sorted(testDescending.begin(), testDescending.end(),
+                    std::greater<int>()),
+                "testDescending, sort() with a comparison object");
+
+        // Objects that own memory must survive the merges
+        DArray<std::string> testWords1;
+        for (int i=0; i < 3000; ++i){
+            testWords1.append(std::to_string((i * 7919) % 3001));
+        }
+
+        DArray<std::string> testWords2(testWords1);
+        std::sort(testWords2.begin(), testWords2.end());
+        par::sort(testWords1.begin(), testWords1.end());
+        CTest1(!testWords1[0].empty() && std::equal(testWords1.begin(),
+                    testWords1.end(), testWords2.begin()),
+                "testWords1, sort() of std::string matching std::sort");
+
+        bool testThrown = false;
+        try{
+            par::for_each(testPar1.begin(), testPar1.end(),
+                    [](long long& x){ if (x == 49999) throw ArrayEmpty();});
+        }catch (ArrayEmpty){
+            testThrown = true;
+        }
+
+        CTest1(testThrown, "testPar1, with exception check for_each() "
+                "passing on the exception of a task");
+
+        par::setSerialThreshold(testOldThreshold);
+        par::usePool(testOldPool);
+    }
+
     cout << "[+] Total tests passed: (" << nPass 
         << "/" << (nPass+nFail) << ")" << endl;
 
@@ -0,0 +1,134 @@
+/*
+ * Filename:      AccessBench.cpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sat Oct 17, 2026 (05:58 PM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// Reduction loop over DArray<float>: checked at() against the
+// unchecked operator[] of release builds and a plain pointer loop.
+//
+// The trip count comes from outside the array (as it does when
+// several arrays are walked together), so the compiler cannot
+// prove the check of at() away. The array fits in L2 so the loop
+// is not limited by memory bandwidth.
+
+
+#include <iostream>
+using std::cout;
+using std::endl;
+#include <chrono>
+#include "../dynarray.hpp"
+using namespace zh;
+
+const size_t ELEMENTS = 64 * 1024;
+const int PASSES = 500;
+const int ROUNDS = 10;
+volatile size_t elementCount = ELEMENTS;
+
+
+template <typename F>
+double timeIt(F job, float& result){
+    double best = 1e30;
+
+    for (int r=0; r < ROUNDS; ++r){
+        auto start = std::chrono::steady_clock::now();
+        for (int p=0; p < PASSES; ++p){
+            result = job();
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(
+                stop - start).count();
+        if (ms < best){
+            best = ms;
+        }
+    }
+
+    return best;
+}
+
+
+int main(void)
+{
+    DArray<float> data;
+    data.reserve(ELEMENTS);
+
+    for (size_t i=0; i < ELEMENTS; ++i){
+        data.append(static_cast<float>(i % 7) * 0.5f);
+    }
+
+    const DArray<float>& view = data;
+    const size_t count = elementCount;
+    float sumAt = 0, sumIndex = 0, sumPointer = 0;
+
+    double msAt = timeIt([&view, count](){
+            float sum = 0;
+            for (size_t i=0; i < count; ++i){
+                sum += view.at(i);
+            }
+            return sum;
+        }, sumAt);
+
+    double msIndex = timeIt([&view, count](){
+            float sum = 0;
+            for (size_t i=0; i < count; ++i){
+                sum += view[i];
+            }
+            return sum;
+        }, sumIndex);
+
+    double msPointer = timeIt([&view, count](){
+            float sum = 0;
+            const float* last = view.begin() + count;
+            for (const float* p = view.begin(); p != last; ++p){
+                sum += *p;
+            }
+            return sum;
+        }, sumPointer);
+
+    cout << "ZH_CHECKED_ACCESS = " << ZH_CHECKED_ACCESS << endl;
+    cout << "at():       " << msAt << " ms  (sum " << sumAt << ")" << endl;
+    cout << "operator[]: " << msIndex << " ms  (sum " << sumIndex << ")" 
+        << endl;
+    cout << "pointer:    " << msPointer << " ms  (sum " << sumPointer 
+        << ")" << endl;
+    cout << "speedup of operator[] over at(): " << msAt / msIndex 
+        << "x" << endl;
+
+    return 0;
+
+    /*
+     * bench/ $ g++ -std=c++14 -O3 -march=native -ffast-math -DNDEBUG \
+     *              AccessBench.cpp -o AccessBench
+     * bench/ $ ./AccessBench
+     * ZH_CHECKED_ACCESS = 0
+     * at():       29.4627 ms  (sum 98301.5)
+     * operator[]: 3.59065 ms  (sum 98301.5)
+     * pointer:    3.57939 ms  (sum 98301.5)
+     * speedup of operator[] over at(): 8.20539x
+     *
+     * Same build without -DNDEBUG (ZH_CHECKED_ACCESS = 1):
+     * at():       43.9941 ms, operator[]: 28.9893 ms, pointer: 3.66161 ms
+     *
+     * -ffast-math lets the compiler reorder the float additions,
+     * without it none of the three loops is vectorized
+     */
+}
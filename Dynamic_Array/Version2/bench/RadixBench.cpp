@@ -0,0 +1,111 @@
+/*
+ * Filename:      RadixBench.cpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (05:00 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// std::sort() against zh::radix_sort() on random 32 bit keys, and
+// against zh::counting_sort() on keys below 1000. Every round sorts
+// a fresh copy of the same input, the copy is included in the time.
+
+
+#include <iostream>
+using std::cout;
+using std::endl;
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "../radixsort.hpp"
+using namespace zh;
+
+const size_t ELEMENTS = 4 * 1024 * 1024;
+const int ROUNDS = 5;
+
+
+template <typename F>
+double timeIt(F job){
+    double best = 1e30;
+
+    for (int r=0; r < ROUNDS; ++r){
+        auto start = std::chrono::steady_clock::now();
+        job();
+        auto stop = std::chrono::steady_clock::now();
+
+        double ms = std::chrono::duration<double, std::milli>(
+                stop - start).count();
+        if (ms < best){
+            best = ms;
+        }
+    }
+
+    return best;
+}
+
+
+int main(void)
+{
+    DArray<uint32_t> random;
+    DArray<uint32_t> small;
+    random.reserve(ELEMENTS);
+    small.reserve(ELEMENTS);
+
+    uint32_t seed = 12345;
+
+    for (size_t i=0; i < ELEMENTS; ++i){
+        seed = seed * 1103515245u + 12345u;
+        random.append(seed);
+        small.append(seed % 1000);
+    }
+
+    volatile uint32_t sink = 0;
+
+    double comparison = timeIt([&]{
+            DArray<uint32_t> copy(random);
+            std::sort(copy.begin(), copy.end());
+            sink = copy[ELEMENTS / 2];
+            });
+    double radix = timeIt([&]{
+            DArray<uint32_t> copy(random);
+            radix_sort(copy);
+            sink = copy[ELEMENTS / 2];
+            });
+
+    cout << "random keys  std::sort     " << comparison << " ms" << endl;
+    cout << "random keys  radix_sort    " << radix << " ms ("
+        << comparison / radix << "x)" << endl;
+
+    comparison = timeIt([&]{
+            DArray<uint32_t> copy(small);
+            std::sort(copy.begin(), copy.end());
+            sink = copy[ELEMENTS / 2];
+            });
+    double counting = timeIt([&]{
+            DArray<uint32_t> copy(small);
+            counting_sort(copy);
+            sink = copy[ELEMENTS / 2];
+            });
+
+    cout << "keys < 1000  std::sort     " << comparison << " ms" << endl;
+    cout << "keys < 1000  counting_sort " << counting << " ms ("
+        << comparison / counting << "x)" << endl;
+
+    return 0;
+}
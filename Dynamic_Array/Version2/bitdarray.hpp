@@ -0,0 +1,633 @@
+/*
+ * Filename:      bitdarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:50 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// DArray<bool, GrowthPolicy>, one bit per flag. Included at the end
+// of dynarray.hpp so the specialization is seen before any
+// DArray<bool> is used.
+
+#ifndef BITDARRAY
+#define BITDARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename GrowthPolicy>
+        class DArray<bool, GrowthPolicy>{
+
+            /*  // Summary of available services
+             *
+             *  Flags are packed 64 to a word, stored in a
+             *  DArray<unsigned long long, GrowthPolicy>, so the
+             *  growth policy counts words. Bits of the last word past
+             *  size() are always zero.
+             *
+             *  Objects can't be addressed, operator[] returns a proxy
+             *  (Reference). Everything listed below has the meaning
+             *  it has in DArray<T>, the rest of the DArray<T>
+             *  services is not provided:
+             *
+             *      begin()/end() and iterators, emplace(),
+             *      emplace_back(), add(), insert(), append(first,
+             *      last), append_n(), remove(), erase(), erase_if(),
+             *      shrink_to_fit(), trim(), resource() and the
+             *      converting constructor in both directions
+             *
+             *  For the same reason bool can't be a field of
+             *  SoADArray, there is no SharedDArray<bool>, and
+             *  DArray<bool> can't be saved by serialize.hpp or
+             *  sorted by radix_sort and counting_sort. zh::par can't
+             *  run reduce(), inclusive_scan() or sort() on bool
+             *  either, as their buffers would be DArray<bool>. All of
+             *  them stop at a static_assert saying so. Copy the flags
+             *  to a DArray<unsigned char> where that is needed.
+             *
+             *  DArray();
+             *
+             *  explicit DArray(size_t);
+             *
+             *  DArray(size_t, const bool&);
+             *
+             *  explicit DArray(MemoryResource&);
+             *
+             *  Reference operator[](size_t);
+             *
+             *  bool operator[](size_t) const;
+             *
+             *  Reference at(size_t);
+             *
+             *  bool at(size_t) const;
+             *
+             *  void resize(size_t, const bool& = false);
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void append(const bool&);
+             *
+             *  void append_word(unsigned long long, size_t = 64);
+             *
+             *  void remove_last();
+             *
+             *  size_t capacity() const;
+             *
+             *  void reserve(size_t);
+             *
+             *  size_t count() const;
+             *
+             *  size_t find_first() const;
+             *
+             *  size_t find_next(size_t) const;
+             *
+             *  void flip();
+             *
+             *  DArray& operator&=(const DArray&);
+             *
+             *  DArray& operator|=(const DArray&);
+             *
+             *  DArray& operator^=(const DArray&);
+             *
+             *  const unsigned long long* words() const;
+             *
+             *  size_t wordCount() const;
+             */
+
+            public:
+                typedef unsigned long long Word;
+                static const size_t WORD_BITS = 64;
+
+
+                class Reference{
+                    // Stands for one bit of the array
+                    public:
+                        Reference(Word* item, Word bitMask) noexcept:
+                            word(item), mask(bitMask){}
+
+                        operator bool() const noexcept{
+                            return (*word & mask) != 0;
+                        }
+
+                        Reference& operator=(bool value) noexcept{
+                            if (value){
+                                *word |= mask;
+                            }else{
+                                *word &= ~mask;
+                            }
+                            return *this;
+                        }
+
+                        Reference& operator=(const Reference& other)
+                            noexcept{
+                            return *this = static_cast<bool>(other);
+                        }
+
+                        void flip() noexcept{
+                            *word ^= mask;
+                        }
+
+                    private:
+                        Word* word;
+                        Word mask;
+                };
+
+
+                DArray();
+
+                explicit DArray(size_t);
+
+                DArray(size_t, const bool&);
+
+                explicit DArray(MemoryResource&);
+                /*
+                 *  Description: Same as DArray<T>, an array of the
+                 *               given number of flags set to false
+                 *               (to the given value)
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 */
+
+
+                Reference operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+                    if (index >= bitCount){
+                        detail::indexFailure(index, bitCount,
+                                "DArray<bool>::operator[]");
+                    }
+#endif
+                    return Reference(storage.begin() + index / WORD_BITS,
+                            Word(1) << (index % WORD_BITS));
+                }
+
+                bool operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    if (index >= bitCount){
+                        detail::indexFailure(index, bitCount,
+                                "DArray<bool>::operator[]");
+                    }
+#endif
+                    return (storage.begin()[index / WORD_BITS] >>
+                            (index % WORD_BITS)) & 1;
+                }
+
+                Reference at(size_t);
+
+                bool at(size_t) const;
+                /*
+                 *  Description: Access the flag at the specified
+                 *               index
+                 *
+                 *  Exception: 1) InvalidIndexException() if the index
+                 *                is not below size
+                 */
+
+
+                void resize(size_t, const bool& = false);
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+
+                void append(const bool&);
+
+                void remove_last();
+
+                size_t capacity() const noexcept;
+
+                void reserve(size_t);
+                /*
+                 *  Description: Same as DArray<T>, sizes count flags
+                 *
+                 *  Remark: Best case: O(1). Worst case: O(n / 64)
+                 */
+
+
+                void append_word(Word, size_t = WORD_BITS);
+                /*
+                 *  Description: Append the lowest bits of the given
+                 *               word, bit 0 first
+                 *
+                 *  Input: 1) Word holding the flags
+                 *         2) Number of flags to take from it, 1 to 64
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 *             2) InvalidIndexException() if the
+                 *                number of flags is 0 or above 64
+                 *
+                 *  Remark: Best case: O(1), two word writes at most
+                 *          whatever the alignment of size()
+                 */
+
+
+                size_t count() const noexcept;
+                /*
+                 *  Description: Returns the number of flags set
+                 *
+                 *  Remark: Best & Worst case: O(n / 64), one
+                 *          population count per word
+                 */
+
+
+                size_t find_first() const noexcept;
+
+                size_t find_next(size_t) const noexcept;
+                /*
+                 *  Description: Returns the index of the first flag
+                 *               set (after the given index), or
+                 *               size() if there is none
+                 *
+                 *  Remark: Worst case: O(n / 64), words without a set
+                 *          flag are skipped whole
+                 */
+
+
+                void flip() noexcept;
+                /*
+                 *  Description: Invert every flag
+                 */
+
+
+                DArray& operator&=(const DArray&) noexcept;
+
+                DArray& operator|=(const DArray&) noexcept;
+
+                DArray& operator^=(const DArray&) noexcept;
+                /*
+                 *  Description: Combine the flags of both arrays
+                 *               word by word. The size of this array
+                 *               does not change, flags past the size
+                 *               of the right hand side count as false
+                 *
+                 *  Remark: Best & Worst case: O(n / 64)
+                 */
+
+
+                const Word* words() const noexcept;
+
+                size_t wordCount() const noexcept;
+                /*
+                 *  Description: The packed flags, flag i is bit
+                 *               (i % 64) of word (i / 64)
+                 */
+
+
+            private:
+                DArray<Word, GrowthPolicy> storage;
+                size_t bitCount;
+
+
+                static size_t wordsFor(size_t bits) noexcept{
+                    return (bits + WORD_BITS - 1) / WORD_BITS;
+                }
+
+                void clearTail() noexcept;
+                /*
+                 *  Description: Zero the bits of the last word past
+                 *               the size, keeps count() and the
+                 *               bitwise operators exact
+                 */
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename G>
+        DArray<bool,G>::DArray(): storage(), bitCount(0){}
+
+
+    template <typename G>
+        DArray<bool,G>::DArray(size_t inputSize):
+            storage(wordsFor(inputSize), Word(0)), bitCount(inputSize){}
+
+
+    template <typename G>
+        DArray<bool,G>::DArray(size_t inputSize, const bool& value):
+            storage(wordsFor(inputSize), value ? ~Word(0) : Word(0)),
+            bitCount(inputSize){
+                clearTail();
+            }
+
+
+    template <typename G>
+        DArray<bool,G>::DArray(MemoryResource& source):
+            storage(source), bitCount(0){}
+
+
+    template <typename G>
+        typename DArray<bool,G>::Reference DArray<bool,G>::at(size_t index){
+            if (index >= bitCount){
+                throw InvalidIndexException();
+            }
+
+            return (*this)[index];
+        }
+
+
+    template <typename G>
+        bool DArray<bool,G>::at(size_t index) const{
+            if (index >= bitCount){
+                throw InvalidIndexException();
+            }
+
+            return (*this)[index];
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::resize(size_t inputSize, const bool& value){
+            bool fill = value;
+
+            if (inputSize > bitCount && fill){
+                // Set the rest of the current last word, the new
+                // words are filled whole
+                Word* last = storage.begin() + bitCount / WORD_BITS;
+                if (bitCount % WORD_BITS != 0){
+                    *last |= ~Word(0) << (bitCount % WORD_BITS);
+                }
+            }
+
+            storage.resize(wordsFor(inputSize), fill ? ~Word(0) : Word(0));
+            bitCount = inputSize;
+            clearTail();
+        }
+
+
+    template <typename G>
+        inline size_t DArray<bool,G>::size() const noexcept{
+            return bitCount;
+        }
+
+
+    template <typename G>
+        inline bool DArray<bool,G>::isEmpty() const noexcept{
+            return bitCount == 0;
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::clear(){
+            storage.clear();
+            bitCount = 0;
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::append(const bool& value){
+            bool flag = value;
+
+            if (bitCount % WORD_BITS == 0){
+                storage.append(Word(0));
+            }
+
+            if (flag){
+                storage.begin()[bitCount / WORD_BITS] |=
+                    Word(1) << (bitCount % WORD_BITS);
+            }
+
+            ++bitCount;
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::remove_last(){
+            if (bitCount == 0){
+                throw ArrayEmpty();
+            }
+
+            --bitCount;
+
+            if (bitCount % WORD_BITS == 0){
+                storage.remove_last();
+            }else{
+                clearTail();
+            }
+        }
+
+
+    template <typename G>
+        inline size_t DArray<bool,G>::capacity() const noexcept{
+            return storage.capacity() * WORD_BITS;
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::reserve(size_t inputSize){
+            storage.reserve(wordsFor(inputSize));
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::append_word(Word word, size_t bits){
+            if (bits == 0 || bits > WORD_BITS){
+                throw InvalidIndexException();
+            }
+
+            if (bits < WORD_BITS){
+                word &= (Word(1) << bits) - 1;
+            }
+
+            size_t offset = bitCount % WORD_BITS;
+
+            if (offset == 0){
+                storage.append(word);
+            }else{
+                // The low part fills the current last word, the
+                // high part (if any) starts a new one
+                storage.begin()[bitCount / WORD_BITS] |= word << offset;
+
+                if (offset + bits > WORD_BITS){
+                    storage.append(word >> (WORD_BITS - offset));
+                }
+            }
+
+            bitCount += bits;
+        }
+
+
+    template <typename G>
+        size_t DArray<bool,G>::count() const noexcept{
+            const Word* item = storage.begin();
+            size_t total = 0;
+
+            for (size_t i=0, n=storage.size(); i < n; ++i){
+                total += __builtin_popcountll(item[i]);
+            }
+
+            return total;
+        }
+
+
+    template <typename G>
+        size_t DArray<bool,G>::find_first() const noexcept{
+            const Word* item = storage.begin();
+
+            for (size_t i=0, n=storage.size(); i < n; ++i){
+                if (item[i] != 0){
+                    return i * WORD_BITS + __builtin_ctzll(item[i]);
+                }
+            }
+
+            return bitCount;
+        }
+
+
+    template <typename G>
+        size_t DArray<bool,G>::find_next(size_t index) const noexcept{
+            size_t start = index + 1;
+
+            if (start >= bitCount){
+                return bitCount;
+            }
+
+            const Word* item = storage.begin();
+            size_t i = start / WORD_BITS;
+            Word current = item[i] & (~Word(0) << (start % WORD_BITS));
+
+            for (size_t n=storage.size(); ; ){
+                if (current != 0){
+                    return i * WORD_BITS + __builtin_ctzll(current);
+                }
+
+                if (++i == n){
+                    return bitCount;
+                }
+
+                current = item[i];
+            }
+        }
+
+
+    template <typename G>
+        void DArray<bool,G>::flip() noexcept{
+            Word* item = storage.begin();
+
+            for (size_t i=0, n=storage.size(); i < n; ++i){
+                item[i] = ~item[i];
+            }
+
+            clearTail();
+        }
+
+
+    template <typename G>
+        DArray<bool,G>& DArray<bool,G>::operator&=(
+                const DArray<bool,G>& rhs) noexcept{
+            Word* item = storage.begin();
+            const Word* other = rhs.storage.begin();
+            size_t n = storage.size();
+            size_t shared = (rhs.storage.size() < n) ? rhs.storage.size() : n;
+
+            for (size_t i=0; i < shared; ++i){
+                item[i] &= other[i];
+            }
+
+            for (size_t i=shared; i < n; ++i){
+                item[i] = 0;
+            }
+
+            return *this;
+        }
+
+
+    template <typename G>
+        DArray<bool,G>& DArray<bool,G>::operator|=(
+                const DArray<bool,G>& rhs) noexcept{
+            Word* item = storage.begin();
+            const Word* other = rhs.storage.begin();
+            size_t n = storage.size();
+            size_t shared = (rhs.storage.size() < n) ? rhs.storage.size() : n;
+
+            for (size_t i=0; i < shared; ++i){
+                item[i] |= other[i];
+            }
+
+            clearTail();
+            return *this;
+        }
+
+
+    template <typename G>
+        DArray<bool,G>& DArray<bool,G>::operator^=(
+                const DArray<bool,G>& rhs) noexcept{
+            Word* item = storage.begin();
+            const Word* other = rhs.storage.begin();
+            size_t n = storage.size();
+            size_t shared = (rhs.storage.size() < n) ? rhs.storage.size() : n;
+
+            for (size_t i=0; i < shared; ++i){
+                item[i] ^= other[i];
+            }
+
+            clearTail();
+            return *this;
+        }
+
+
+    template <typename G>
+        inline const typename DArray<bool,G>::Word*
+        DArray<bool,G>::words() const noexcept{
+            return storage.begin();
+        }
+
+
+    template <typename G>
+        inline size_t DArray<bool,G>::wordCount() const noexcept{
+            return storage.size();
+        }
+
+
+    template <typename G>
+        inline void DArray<bool,G>::clearTail() noexcept{
+            if (bitCount % WORD_BITS != 0){
+                storage.begin()[bitCount / WORD_BITS] &=
+                    (Word(1) << (bitCount % WORD_BITS)) - 1;
+            }
+        }
+
+} // namespace zh
+
+#endif /* ifndef BITDARRAY */
@@ -0,0 +1,446 @@
+/*
+ * Filename:      concurrentarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (01:30 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef CONCURRENTARRAY
+#define CONCURRENTARRAY
+#include "dynarray.hpp"
+#include "segarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <new>
+using std::bad_alloc;
+#include <atomic>
+#include <utility>
+#include <type_traits>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t FIRST = 1024>
+        class ConcurrentAppendArray{
+
+            /*  // Summary of available services
+             *
+             *  Grow-only array that any number of threads can append
+             *  to at the same time, while others read it, without
+             *  locks.
+             *
+             *  An append takes the next index with one atomic
+             *  fetch-add and constructs its object in a segment.
+             *  Segment k holds FIRST << k objects and is never moved,
+             *  so growing copies nothing. Objects are published in
+             *  index order: size() only covers objects whose
+             *  construction is complete together with all objects
+             *  before them, and reading any index below size() needs
+             *  no lock.
+             *
+             *  ConcurrentAppendArray() noexcept;
+             *
+             *  ~ConcurrentAppendArray() noexcept;
+             *
+             *  size_t append(const T&);
+             *
+             *  size_t append(T&&);
+             *
+             *  template <typename... Args>
+             *      size_t emplace_back(Args&&...);
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  const T& at(size_t) const;
+             */
+
+            static_assert(FIRST > 0 && (FIRST & (FIRST - 1)) == 0,
+                    "FIRST must be a power of two");
+            static_assert(std::is_nothrow_move_constructible<T>::value,
+                    "ConcurrentAppendArray needs a non-throwing move "
+                    "constructor");
+
+            public:
+
+                ConcurrentAppendArray() noexcept;
+                /*
+                 *  Description: Create an empty array, no memory is
+                 *               allocated until the first append
+                 *
+                 *  Exception: None
+                 */
+
+
+                ~ConcurrentAppendArray() noexcept;
+                /*
+                 *  Description: Destroy every object and release the
+                 *               segments
+                 *
+                 *  Pre-condition: 1) No other thread uses the array
+                 */
+
+
+                ConcurrentAppendArray(const ConcurrentAppendArray&) = delete;
+                ConcurrentAppendArray& operator=(
+                        const ConcurrentAppendArray&) = delete;
+
+
+                size_t append(const T&);
+
+                size_t append(T&&);
+
+                template <typename... Args>
+                    size_t emplace_back(Args&&...);
+                /*
+                 *  Description: Add a new object at the end of the
+                 *               array, safe to call from any number
+                 *               of threads at the same time
+                 *
+                 *  Output: 1) Index of the new object
+                 *
+                 *  Post-condition: 1) The object is visible to
+                 *                     readers once every object with
+                 *                     a smaller index is complete
+                 *
+                 *  Exception: 1) An exception of the constructor of
+                 *                <T> is passed on, nothing is added
+                 *                (the object is built before an index
+                 *                is taken)
+                 *             2) OutOfMemory() if a new segment can't
+                 *                be allocated. The index taken can't
+                 *                be given back, so from then on the
+                 *                array stops publishing and every
+                 *                append throws OutOfMemory(). Objects
+                 *                published before stay readable
+                 *
+                 *  Remark: Best case: O(1), one fetch-add and one
+                 *          move. A thread that completes the oldest
+                 *          unpublished object publishes every
+                 *          complete object after it as well
+                 */
+
+
+                size_t size() const noexcept;
+                /*
+                 *  Description: Returns the number of published
+                 *               objects, indices below it can be
+                 *               read from any thread
+                 */
+
+
+                bool isEmpty() const noexcept;
+
+
+                const T& operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    size_t published = size();
+                    if (index >= published){
+                        detail::indexFailure(index, published,
+                                "ConcurrentAppendArray::operator[]");
+                    }
+#endif
+                    return *slot(index);
+                }
+
+                const T& at(size_t) const;
+                /*
+                 *  Description: Read the object at the specified index
+                 *
+                 *  Exception: 1) InvalidIndexException() if the index
+                 *                is not below size()
+                 *
+                 *  Remark: Best & Worst case: O(1), a bit scan finds
+                 *          the segment
+                 */
+
+
+            private:
+
+                static const size_t SHIFT = detail::Log2<FIRST>::value;
+                static const size_t SEGMENTS = 64 - SHIFT;
+
+                std::atomic<T*> segments[SEGMENTS];
+                std::atomic<size_t> reserved;
+                std::atomic<size_t> published;
+                std::atomic<bool> broken;
+
+
+                static size_t segmentOf(size_t index) noexcept{
+                    // Segment k starts at (FIRST << k) - FIRST
+                    return 63 - __builtin_clzll(
+                            static_cast<unsigned long long>(index + FIRST))
+                        - SHIFT;
+                }
+
+                static size_t offsetOf(size_t index, size_t segment)
+                    noexcept{
+                    return index + FIRST - (FIRST << segment);
+                }
+
+                static size_t segmentBytes(size_t segment) noexcept{
+                    // Objects first, then one ready flag per object
+                    return (FIRST << segment) * (sizeof(T) +
+                            sizeof(std::atomic<unsigned char>));
+                }
+
+
+                T* slot(size_t index) const noexcept;
+                /*
+                 *  Description: Address of the object at the index,
+                 *               its segment has to exist
+                 */
+
+
+                T* segmentFor(size_t);
+                /*
+                 *  Description: Returns the segment of the index,
+                 *               allocating it if no thread has yet.
+                 *               Threads racing for the same segment
+                 *               agree through a compare-exchange and
+                 *               the losers release their copy
+                 *
+                 *  Exception: 1) bad_alloc if the segment can't be
+                 *                allocated
+                 */
+
+
+                void publish(size_t) noexcept;
+                /*
+                 *  Description: Mark the object at the index complete
+                 *               and move the published size past
+                 *               every complete object
+                 */
+
+
+                bool isReady(size_t) const noexcept;
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t F>
+        ConcurrentAppendArray<T,F>::ConcurrentAppendArray() noexcept:
+            reserved(0), published(0), broken(false){
+                for (size_t i=0; i < SEGMENTS; ++i){
+                    segments[i].store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+
+    template <typename T, size_t F>
+        ConcurrentAppendArray<T,F>::~ConcurrentAppendArray() noexcept{
+            size_t taken = reserved.load(std::memory_order_acquire);
+
+            for (size_t i=0; i < SEGMENTS; ++i){
+                T* items = segments[i].load(std::memory_order_acquire);
+
+                if (items == nullptr){
+                    continue;
+                }
+
+                size_t length = F << i;
+                size_t first = (F << i) - F;
+
+                for (size_t j=0; j < length && first + j < taken; ++j){
+                    if (isReady(first + j)){
+                        (&items[j])->~T();
+                    }
+                }
+
+                newDeleteResource()->deallocate(items, segmentBytes(i),
+                        alignof(T));
+            }
+        }
+
+
+    template <typename T, size_t F>
+        size_t ConcurrentAppendArray<T,F>::append(const T& value){
+            return emplace_back(value);
+        }
+
+
+    template <typename T, size_t F>
+        size_t ConcurrentAppendArray<T,F>::append(T&& value){
+            return emplace_back(std::move(value));
+        }
+
+
+    template <typename T, size_t F>
+        template <typename... Args>
+        size_t ConcurrentAppendArray<T,F>::emplace_back(Args&&... args){
+            if (broken.load(std::memory_order_relaxed)){
+                throw OutOfMemory();
+            }
+
+            // Built first, so a throwing constructor can't leave
+            // a taken index without an object
+            T item(std::forward<Args>(args)...);
+            size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+            T* items = nullptr;
+
+            try{
+                items = segmentFor(index);
+            }catch (bad_alloc){
+                broken.store(true, std::memory_order_relaxed);
+                throw OutOfMemory();
+            }
+
+            new (items + offsetOf(index, segmentOf(index))) T(std::move(item));
+            publish(index);
+
+            return index;
+        }
+
+
+    template <typename T, size_t F>
+        inline size_t ConcurrentAppendArray<T,F>::size() const noexcept{
+            // acquire pairs with publish(), everything below the
+            // returned size is fully constructed and visible
+            return published.load(std::memory_order_acquire);
+        }
+
+
+    template <typename T, size_t F>
+        inline bool ConcurrentAppendArray<T,F>::isEmpty() const noexcept{
+            return size() == 0;
+        }
+
+
+    template <typename T, size_t F>
+        const T& ConcurrentAppendArray<T,F>::at(size_t index) const{
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            return *slot(index);
+        }
+
+
+    template <typename T, size_t F>
+        inline T* ConcurrentAppendArray<T,F>::slot(size_t index)
+        const noexcept{
+            size_t segment = segmentOf(index);
+            return segments[segment].load(std::memory_order_acquire) +
+                offsetOf(index, segment);
+        }
+
+
+    template <typename T, size_t F>
+        T* ConcurrentAppendArray<T,F>::segmentFor(size_t index){
+            size_t segment = segmentOf(index);
+            T* items = segments[segment].load(std::memory_order_acquire);
+
+            if (items != nullptr){
+                return items;
+            }
+
+            size_t length = F << segment;
+            unsigned char* made = static_cast<unsigned char*>(
+                    newDeleteResource()->allocate(segmentBytes(segment),
+                        alignof(T)));
+            std::atomic<unsigned char>* ready =
+                reinterpret_cast<std::atomic<unsigned char>*>(
+                        made + length * sizeof(T));
+
+            for (size_t i=0; i < length; ++i){
+                new (ready + i) std::atomic<unsigned char>(0);
+            }
+
+            // The flags live behind the objects, installing the
+            // segment pointer publishes both
+            T* mine = reinterpret_cast<T*>(made);
+
+            if (segments[segment].compare_exchange_strong(items, mine,
+                        std::memory_order_acq_rel,
+                        std::memory_order_acquire)){
+                return mine;
+            }
+
+            newDeleteResource()->deallocate(made, segmentBytes(segment),
+                    alignof(T));
+            return items;
+        }
+
+
+    template <typename T, size_t F>
+        bool ConcurrentAppendArray<T,F>::isReady(size_t index) const noexcept{
+            size_t segment = segmentOf(index);
+            T* items = segments[segment].load(std::memory_order_acquire);
+
+            if (items == nullptr){
+                return false;
+            }
+
+            const std::atomic<unsigned char>* ready =
+                reinterpret_cast<const std::atomic<unsigned char>*>(
+                        reinterpret_cast<const unsigned char*>(items) +
+                        (F << segment) * sizeof(T));
+
+            return ready[offsetOf(index, segment)].load() != 0;
+        }
+
+
+    template <typename T, size_t F>
+        void ConcurrentAppendArray<T,F>::publish(size_t index) noexcept{
+            size_t segment = segmentOf(index);
+            std::atomic<unsigned char>* ready =
+                reinterpret_cast<std::atomic<unsigned char>*>(
+                        reinterpret_cast<unsigned char*>(
+                            segments[segment].load(
+                                std::memory_order_acquire)) +
+                        (F << segment) * sizeof(T));
+
+            // Sequentially consistent flag and size operations: a
+            // thread finishing an older object either sees our flag
+            // and publishes us, or we see its flag here
+            ready[offsetOf(index, segment)].store(1);
+
+            size_t current = published.load();
+
+            while (current < reserved.load() && isReady(current)){
+                // On failure current is reloaded and checked again
+                if (published.compare_exchange_weak(current, current + 1)){
+                    ++current;
+                }
+            }
+        }
+
+} // namespace zh
+
+#endif /* ifndef CONCURRENTARRAY */
@@ -2,7 +2,7 @@
  * Filename:      darray.hpp
  * Version:       2.0
  * Author:        zah
- * Last Modified: Thu Nov 10, 2016 (09:17 AM)
+ * Last Modified: Sun Oct 18, 2026 (07:05 AM)
  *
  * Copyright © 2016 zah
  *
@@ -28,6 +28,33 @@
 using std::size_t;
 #include <new>
 using std::bad_alloc;
+#include <utility>
+#include <type_traits>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include "memresource.hpp"
+#include "instrument.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+
+// Checking mode of operator[]
+//
+// 0: operator[] does no checking at all so loops over a DArray 
+//    can be vectorized, use at() for a checked access
+// 1: an index out of range aborts the program with the index
+//    and the size of the array, like a failed assert()
+//
+// Defaults to 1 unless NDEBUG is defined (release builds)
+
+#ifndef ZH_CHECKED_ACCESS
+#ifdef NDEBUG
+#define ZH_CHECKED_ACCESS 0
+#else
+#define ZH_CHECKED_ACCESS 1
+#endif
+#endif
 
 
 namespace zh{
@@ -43,11 +70,339 @@ namespace zh{
     class OutOfMemory{};
     class ArrayEmpty{};
     class InvalidIndexException{};
+    class KeyNotFound{};
+    class FormatMismatch{};
 
-    template <typename T>
+
+    namespace detail{
+
+        [[noreturn]] inline void indexFailure(size_t index, size_t size,
+                const char* function) noexcept{
+            std::fprintf(stderr, "%s: index %zu is out of range "
+                    "(size %zu)\n", function, index, size);
+            std::abort();
+        }
+
+
+        // Types that expose their characters through c_str() and
+        // length(), such as std::string and String, are hashed and
+        // serialized as text instead of as objects
+
+        template <typename K, typename = void>
+            struct IsText: std::false_type{};
+
+        template <typename K>
+            struct IsText<K, decltype(void(std::declval<const K&>().c_str()),
+                    void(std::declval<const K&>().length()))>:
+            std::true_type{};
+
+
+        // Relocation engine used whenever objects have to be
+        // carried over to a new heap.
+        //
+        // Trivially copyable objects are copied with one memcpy.
+        // Everything else is moved if its move constructor
+        // cannot throw, otherwise it is copied (move_if_noexcept)
+        // so that the source objects are untouched if a
+        // constructor throws half way through.
+
+        typedef std::true_type  BitwiseRelocation;
+        typedef std::false_type ObjectRelocation;
+
+
+        template <typename T>
+            void relocate(T* source, T* destination, size_t count,
+                    BitwiseRelocation){
+                if (count > 0){
+                    std::memcpy(static_cast<void*>(destination),
+                            static_cast<const void*>(source),
+                            count * sizeof(T));
+                }
+            }
+
+
+        template <typename T>
+            void relocate(T* source, T* destination, size_t count,
+                    ObjectRelocation){
+                size_t i = 0;
+
+                try{
+                    for (; i < count; ++i){
+                        new (destination + i) 
+                            T(std::move_if_noexcept(*(source+i)));
+                    }
+                }catch (...){
+                    // Cleanup phase, source objects are still
+                    // intact unless T has a throwing move and
+                    // no copy constructor
+                    while (i > 0){
+                        --i;
+                        (&destination[i])->~T();
+                    }
+                    throw;
+                }
+
+                for (i=0; i < count; ++i){
+                    (&source[i])->~T();
+                }
+            }
+
+
+        template <typename T>
+            inline void relocate(T* source, T* destination, size_t count){
+                relocate(source, destination, count, 
+                        typename std::is_trivially_copyable<T>::type());
+            }
+
+
+
+        // Conversion engine of the converting constructor, every
+        // object is built once directly from its source object.
+        //
+        // Between arithmetic types it is a plain loop over raw
+        // pointers the compiler turns into vector widening or
+        // narrowing instructions, anything else is constructed in
+        // place and rolled back if a constructor throws.
+
+        typedef std::true_type  ArithmeticConversion;
+        typedef std::false_type ObjectConversion;
+
+
+        template <typename Y, typename T>
+            void convert(const Y* __restrict source, T* __restrict destination,
+                    size_t count, ArithmeticConversion) noexcept{
+                for (size_t i=0; i < count; ++i){
+                    destination[i] = static_cast<T>(source[i]);
+                }
+            }
+
+
+        template <typename Y, typename T>
+            void convert(const Y* source, T* destination, size_t count,
+                    ObjectConversion){
+                size_t i = 0;
+
+                try{
+                    for (; i < count; ++i){
+                        new (destination + i) T(static_cast<T>(source[i]));
+                    }
+                }catch (...){
+                    while (i > 0){
+                        --i;
+                        (&destination[i])->~T();
+                    }
+                    throw;
+                }
+            }
+
+
+        template <typename Y, typename T>
+            inline void convert(const Y* source, T* destination, 
+                    size_t count){
+                convert(source, destination, count, 
+                        std::integral_constant<bool, 
+                        std::is_arithmetic<Y>::value &&
+                        std::is_arithmetic<T>::value>());
+            }
+
+        // Forward iterator over count copies of one object, lets
+        // insert(index, count, value) share the code of the range
+        // insert
+
+        template <typename T>
+            class RepeatIterator{
+                public:
+                    typedef std::forward_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef const T* pointer;
+                    typedef const T& reference;
+
+                    RepeatIterator(const T& item, size_t index):
+                        value(&item), position(index){}
+
+                    const T& operator*() const{ return *value;}
+
+                    RepeatIterator& operator++(){
+                        ++position;
+                        return *this;
+                    }
+
+                    RepeatIterator operator++(int){
+                        RepeatIterator old(*this);
+                        ++position;
+                        return old;
+                    }
+
+                    bool operator==(const RepeatIterator& other) const{
+                        return position == other.position;
+                    }
+
+                    bool operator!=(const RepeatIterator& other) const{
+                        return position != other.position;
+                    }
+
+                private:
+                    const T* value;
+                    size_t position;
+            };
+
+    } // namespace detail
+
+    //--------------------------------------------||
+    //						  ||
+    // 	             Growth policies              ||
+    //					          ||
+    //--------------------------------------------||
+
+    /*
+     *  A growth policy decides how many objects the heap of a
+     *  DArray can hold. It is a class with two static functions,
+     *  so the choice is made at compile time and costs nothing
+     *  at run time:
+     *
+     *      static size_t initial(size_t size);
+     *          Physical size given to a new array of the
+     *          specified logical size
+     *
+     *      static size_t grow(size_t capacity, size_t required);
+     *          Physical size to reallocate to when an array of
+     *          the given capacity needs room for at least
+     *          required objects (the result is >= required)
+     *
+     *  and optionally a third one, called after objects have been
+     *  removed:
+     *
+     *      static size_t shrink(size_t capacity, size_t size);
+     *          Physical size to reallocate to, or capacity to
+     *          keep the current heap (the result is >= size)
+     */
+
+
+    template <size_t NUM = 3, size_t DEN = 2, size_t MIN = 5>
+        class GeometricGrowth{
+            // Grows to NUM/DEN times the required size,
+            // small arrays get MIN objects up front
+            static_assert(DEN > 0 && NUM >= DEN, 
+                    "GeometricGrowth needs a factor of at least 1");
+
+            public:
+                static size_t initial(size_t size) noexcept{
+                    return (size <= MIN) ? MIN : size / DEN * NUM 
+                        + size % DEN * NUM / DEN;
+                }
+
+                static size_t grow(size_t, size_t required) noexcept{
+                    return initial(required);
+                }
+        };
+
+
+    template <size_t MIN = 8>
+        class PowerOfTwoGrowth{
+            // Rounds up to the next power of two
+            static_assert(MIN > 0, "PowerOfTwoGrowth needs MIN > 0");
+
+            public:
+                static size_t initial(size_t size) noexcept{
+                    size_t result = MIN;
+
+                    while (result < size){
+                        result <<= 1;
+                    }
+
+                    return result;
+                }
+
+                static size_t grow(size_t, size_t required) noexcept{
+                    return initial(required);
+                }
+        };
+
+
+    template <size_t CHUNK = 64>
+        class ChunkGrowth{
+            // Rounds up to a multiple of CHUNK objects, so each
+            // reallocation adds a fixed amount of memory
+            static_assert(CHUNK > 0, "ChunkGrowth needs a non-zero chunk");
+
+            public:
+                static size_t initial(size_t size) noexcept{
+                    return grow(0, (size > 0) ? size : 1);
+                }
+
+                static size_t grow(size_t, size_t required) noexcept{
+                    return ((required + CHUNK - 1) / CHUNK) * CHUNK;
+                }
+        };
+
+
+    class ExactGrowth{
+        // Never allocates more than requested, meant for
+        // arrays whose size is known and reserve()d up front
+        public:
+            static size_t initial(size_t size) noexcept{
+                return size;
+            }
+
+            static size_t grow(size_t, size_t required) noexcept{
+                return required;
+            }
+    };
+
+
+    // Matches the original behaviour: at least 5 objects,
+    // otherwise 1.5 times the required size
+    typedef GeometricGrowth<3, 2, 5> DefaultGrowth;
+
+
+    template <typename Base = DefaultGrowth, size_t NUM = 1, size_t DEN = 4>
+        class AutoShrink: public Base{
+            // Grows like Base. Once less than NUM/DEN of the heap
+            // is in use it shrinks to what Base::initial() gives
+            // for the current size. The gap between NUM/DEN and
+            // the growth factor keeps an array that hovers around
+            // a size from reallocating back and forth.
+            //
+            // Removing objects may then move the remaining ones,
+            // so pointers and iterators are invalidated by
+            // remove(), remove_last(), erase(), erase_if(),
+            // resize() and clear() as well
+            static_assert(DEN > 0 && NUM < DEN,
+                    "AutoShrink needs a ratio below 1");
+
+            public:
+                static size_t shrink(size_t capacity, size_t size) noexcept{
+                    if (size * DEN < capacity * NUM){
+                        size_t target = Base::initial(size);
+                        return (target < capacity) ? target : capacity;
+                    }
+
+                    return capacity;
+                }
+        };
+
+
+    namespace detail{
+
+        template <typename G, typename = void>
+            struct HasShrink: std::false_type{};
+
+        template <typename G>
+            struct HasShrink<G, decltype(void(G::shrink(size_t(), size_t())))>:
+            std::true_type{};
+
+    } // namespace detail
+
+
+    template <typename T, typename GrowthPolicy = DefaultGrowth>
         class DArray{
 
             /*  // Summary of available services
+             *
+             *  GrowthPolicy: see "Growth policies" above, decides
+             *  how much memory is preallocated on every
+             *  reallocation (DefaultGrowth if not specified)
              *
              *  DArray();
              *
@@ -55,16 +410,28 @@ namespace zh{
              *
              *  DArray(size_t, const T&);
              *
+             *  explicit DArray(MemoryResource&);
+             *
+             *  DArray(size_t, const T&, MemoryResource&);
+             *
              *  ~DArray() noexcept;
              *  
-             *  DArray(const DArray<T>&);
+             *  DArray(const DArray<T,GrowthPolicy>&);
+             *
+             *  DArray<T,GrowthPolicy>& operator=(const DArray<T,GrowthPolicy>&);
+             *
+             *  DArray(DArray<T,GrowthPolicy>&&) noexcept;
              *
-             *  DArray<T>& operator=(const DArray<T>&);
+             *  DArray<T,GrowthPolicy>& operator=(DArray<T,GrowthPolicy>&&) noexcept;
              *
              *  const T& operator[](size_t) const;
              *
              *  T& operator[](size_t);
              *
+             *  const T& at(size_t) const;
+             *
+             *  T& at(size_t);
+             *
              *  void resize(size_t, const T& = T());
              *
              *  size_t size() const;
@@ -77,16 +444,47 @@ namespace zh{
              *  
              *  void append(const T&);
              *
+             *  void add(T&&, size_t);
+             *
+             *  void append(T&&);
+             *
+             *  template <typename... Args>
+             *      void emplace_back(Args&&...);
+             *
+             *  template <typename... Args>
+             *      void emplace(size_t, Args&&...);
+             *
+             *  template <typename InputIt>
+             *      void append(InputIt, InputIt);
+             *
+             *  void append_n(size_t, const T&);
+             *
+             *  template <typename InputIt>
+             *      void insert(size_t, InputIt, InputIt);
+             *
+             *  void insert(size_t, size_t, const T&);
+             *
+             *  void erase(size_t, size_t);
+             *
+             *  template <typename Predicate>
+             *      size_t erase_if(Predicate);
+             *
              *  void remove(size_t index);
              *
              *  void remove_last();
              *
-             *  template <typename Y>
-             *      DArray(const DArray<Y>&);
+             *  template <typename Y, typename P>
+             *      DArray(const DArray<Y,P>&);
              *      
              *  size_t capacity() const;
              *
              *  void reserve(size_t);
+             *
+             *  void shrink_to_fit();
+             *
+             *  bool trim(double = 0.5);
+             *
+             *  MemoryResource* resource() const;
              */
 
 
@@ -162,8 +560,9 @@ namespace zh{
                  *
                  *          Best case: O(1), as we preallocate buffer 
                  *          to a fixed size is the specified input size 
-                 *          is less than or equal to 5. Which is why we 
-                 *          can always do the job in constant time
+                 *          is less than or equal to 5 (DefaultGrowth).
+                 *          Which is why we can always do the job in
+                 *          constant time
                  */
 
 
@@ -213,6 +612,61 @@ namespace zh{
                  */
 
 
+                explicit DArray(MemoryResource&);
+                /*
+                 *  Description: Create an empty Dynamic Array object
+                 *               whose heap is obtained from the
+                 *               specified memory resource
+                 *
+                 *  Input: 1) Memory resource (see memresource.hpp)
+                 *            that will provide every buffer of this
+                 *            array
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition:  1) The memory resource outlives
+                 *                     the array
+                 *
+                 *  Post-condition: 1) Same as DArray(), except all
+                 *                     allocations and deallocations of
+                 *                     this array (including after a
+                 *                     reserve()) go through the given
+                 *                     resource
+                 *
+                 *  Exception: 1) If the resource fails to provide
+                 *                memory OutOfMemory() will be thrown
+                 *
+                 *  Remark: Best & Worse case: O(1), same as DArray()
+                 */
+
+
+                DArray(size_t, const T&, MemoryResource&);
+                /*
+                 *  Description: Same as DArray(size_t, const T&)
+                 *               except the heap is obtained from the
+                 *               specified memory resource
+                 *
+                 *  Input: 1) Initial size of the array 
+                 *         2) Value the objects in the array will be
+                 *            initialized to
+                 *         3) Memory resource that will provide every
+                 *            buffer of this array
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition:  1) The memory resource outlives
+                 *                     the array
+                 *
+                 *  Post-condition: 1) Same as DArray(size_t, const T&)
+                 *
+                 *  Exception: 1) If the resource fails to provide
+                 *                memory OutOfMemory() will be thrown
+                 *
+                 *  Remark: Best & Worst case: same as 
+                 *          DArray(size_t, const T&)
+                 */
+
+
                 ~DArray() noexcept;
                 /*
                  *  Description: Delete the array object and cleanup
@@ -242,7 +696,7 @@ namespace zh{
                  */
 
 
-                DArray(const DArray<T>&);
+                DArray(const DArray<T,GrowthPolicy>&);
                 /*
                  *  Description: Create & initialize our Dynamic array to
                  *               represent the same state as the input
@@ -285,7 +739,7 @@ namespace zh{
                  */
 
 
-                DArray<T>& operator=(const DArray<T>&);
+                DArray<T,GrowthPolicy>& operator=(const DArray<T,GrowthPolicy>&);
                 /*
                  *  Description: Change existing state of our dynamic
                  *               array to represent the state of the
@@ -327,6 +781,65 @@ namespace zh{
                  */
 
 
+                DArray(DArray<T,GrowthPolicy>&&) noexcept;
+                /*
+                 *  Description: Create our Dynamic array by taking over
+                 *               the buffer of the input Dynamic array
+                 *               object instead of copying its objects
+                 *
+                 *  Input: Dynamic array object of type <T> whose
+                 *         state we wish to take over
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: None
+                 *
+                 *  Post-condition: 1) Our new dynamic array will own
+                 *                     the buffer and objects of the
+                 *                     input object
+                 *                  2) The input object is left empty
+                 *                     with no buffer, it can still be
+                 *                     assigned to or destroyed safely
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: Best & Worst case: O(1), as we only swap
+                 *          a few pointers and sizes no matter how
+                 *          many objects are in the array
+                 */
+
+
+                DArray<T,GrowthPolicy>& operator=(DArray<T,GrowthPolicy>&&) noexcept;
+                /*
+                 *  Description: Release our current objects and take
+                 *               over the buffer of the input Dynamic
+                 *               array object
+                 *
+                 *  Input: 1) Dynamic array object whose state we
+                 *            wish to take over
+                 *
+                 *  Output: 1) Modified dynamic array object
+                 *             is returned
+                 *
+                 *  Pre-condition: None
+                 *
+                 *  Post-condition: 1) Our previous objects are
+                 *                     destroyed and our buffer is
+                 *                     released
+                 *                  2) We own the buffer and objects
+                 *                     of the input object which is
+                 *                     left empty with no buffer
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: Worst case: O(n), as we have to destroy the
+                 *          n objects we were holding before
+                 *
+                 *          Best case: O(1), when our array is empty
+                 *          or the input object is the same object
+                 */
+
+
                 const T& operator[](size_t) const;
                 /*
                  *  Description: Provide read only access to a
@@ -344,9 +857,12 @@ namespace zh{
                  *  Post-condition: 1) We will not make any modification
                  *                     to the state of our array object
                  *
-                 *  Exception: 1) Throws InvalidIndexException() if the
-                 *                input index is equal to or greater
-                 *                than the size of the array
+                 *  Exception: None, the index is not checked unless
+                 *             ZH_CHECKED_ACCESS is 1 (the default
+                 *             without NDEBUG), in which case an index
+                 *             out of range aborts the program after
+                 *             printing the index and the size. Use
+                 *             at() to get an exception instead
                  *
                  *  Remark: Best & Worst case: O(1), as we can provide 
                  *          access in constant time
@@ -371,13 +887,63 @@ namespace zh{
                  *  Post-condition: 1) We will not make any modification
                  *                     to the state of our array object
                  *
+                 *  Exception: None, the index is not checked unless
+                 *             ZH_CHECKED_ACCESS is 1 (the default
+                 *             without NDEBUG), in which case an index
+                 *             out of range aborts the program after
+                 *             printing the index and the size. Use
+                 *             at() to get an exception instead
+                 *
+                 *  Remark: Best & Worst case: O(1), as we can provide 
+                 *          access in constant time
+                 *
+                 */
+
+
+                const T& at(size_t) const;
+                /*
+                 *  Description: Provide read only access to a
+                 *               particular object at the specified
+                 *               index after checking the index
+                 *
+                 *  Input: 1) Index of the requested object in the array
+                 *
+                 *  Output: 1) The object at the specified index
+                 *
+                 *  Pre-condition: None
+                 *
+                 *  Post-condition: 1) We will not make any modification
+                 *                     to the state of our array object
+                 *
                  *  Exception: 1) Throws InvalidIndexException() if the
                  *                input index is equal to or greater
                  *                than the size of the array
                  *
                  *  Remark: Best & Worst case: O(1), as we can provide 
                  *          access in constant time
+                 */
+
+
+                T& at(size_t);
+                /*
+                 *  Description: Provide read and write access to a
+                 *               particular object at the specified
+                 *               index after checking the index
+                 *
+                 *  Input: 1) Index of the requested object in the array
+                 *
+                 *  Output: 1) The object at the specified index
                  *
+                 *  Pre-condition: None
+                 *
+                 *  Post-condition: None
+                 *
+                 *  Exception: 1) Throws InvalidIndexException() if the
+                 *                input index is equal to or greater
+                 *                than the size of the array
+                 *
+                 *  Remark: Best & Worst case: O(1), as we can provide 
+                 *          access in constant time
                  */
 
 
@@ -541,7 +1107,7 @@ namespace zh{
                  *  Post-condition: 1) We will add the specified
                  *                     value to the element at the
                  *                     specified index by calling the 
-                 *                     objects assignment operator 
+                 *                     objects copy constructor
                  *                     and make sure that the previous 
                  *                     value is not overwritten by 
                  *                     shifting them appropriately 
@@ -603,34 +1169,372 @@ namespace zh{
                  *          object into the array
                  *
                  *          Best Case: O(1), as the buffer size is
-                 *          large enough so we can just append the
-                 *          new object in constant time
+                 *          large enough so we can just copy construct
+                 *          the new object at the end of the buffer
+                 *
+                 *          Since the buffer grows geometrically the
+                 *          amortized cost of an append is O(1)
                  *          
                  */
 
 
-                void remove(size_t index);
+                void add(T&&, size_t);
                 /*
-                 *  Description: Remove an object from the specified
-                 *               index
+                 *  Description: Same as add(const T&, size_t) except
+                 *               the input object is moved into the
+                 *               array instead of being copied
                  *
-                 *  Input: 1) Index of the object that we want to
-                 *            remove from the array
+                 *  Input: 1) Object that we want to move into the
+                 *            array
+                 *         2) Index at which we want to add the
+                 *            element
                  *
                  *  Output: None
                  *
-                 *  Pre-condition: 1) Index has to be with in valid
-                 *                    range which is 0 to size-1
+                 *  Pre-condition: 1) We assume sufficient memory is
+                 *                    available
+                 *                 2) Index has to be with in valid
+                 *                    range which is zero to size
                  *
-                 *  Post-condition: 1) The object at the specified
-                 *                     index will be removed and the
-                 *                     objects following it (if any)
-                 *                     will be shifted accordingly
-                 *                     to the left
+                 *  Post-condition: 1) The object is moved to the
+                 *                     specified index and the objects
+                 *                     following it are moved one
+                 *                     position to the right
+                 *                  2) The input object is left in a
+                 *                     valid but unspecified state
                  *
-                 *  Exception: 1) InvalidIndexException will be
-                 *                thrown if the index is not with in
-                 *                the valid range which is 0
+                 *  Exception: 1) Throws OutOfMemory() if insufficient
+                 *                memory is available
+                 *             2) Throws InvalidIndexException()
+                 *                when the index is greater than
+                 *                the valid range (zero to size)
+                 *
+                 *  Remark: Worst Case: O(n), as we may have to
+                 *          reallocate the buffer or shift n objects
+                 *
+                 *          Best Case: O(1), when the index is equal
+                 *          to size and the buffer is large enough
+                 */
+
+
+                void append(T&&);
+                /*
+                 *  Description: Move the specified object to the
+                 *               end of the array
+                 *
+                 *  Input: Object that will be moved into the array
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *
+                 *  Post-condition: 1) The object is move constructed
+                 *                     at the end of the array
+                 *                  2) Size of Dynamic Array will be
+                 *                     incremented by 1
+                 *
+                 *  Exception: 1) OutOfMemory() exception will be
+                 *                thrown if we fail to get
+                 *                sufficient memory
+                 *
+                 *  Remark: Worst Case: O(n), as we may have to
+                 *          reallocate the buffer
+                 *
+                 *          Best Case: O(1), as the buffer size is
+                 *          large enough so we only construct one
+                 *          object in place
+                 */
+
+
+                template <typename... Args>
+                    void emplace_back(Args&&...);
+                /*
+                 *  Description: Construct a new object at the end of
+                 *               the array directly from the given
+                 *               constructor arguments
+                 *
+                 *  Input: Arguments that are forwarded to one of the
+                 *         constructors of type <T>
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *                 2) Type <T> has a constructor that
+                 *                    accepts the given arguments
+                 *
+                 *  Post-condition: 1) A new object is constructed in
+                 *                     place on our heap right after
+                 *                     the last object, no temporary
+                 *                     object is created unless the
+                 *                     buffer has to be reallocated
+                 *                  2) Size of Dynamic Array will be
+                 *                     incremented by 1
+                 *
+                 *  Exception: 1) OutOfMemory() exception will be
+                 *                thrown if we fail to get
+                 *                sufficient memory
+                 *             2) Any exception thrown by the
+                 *                constructor of <T> is passed on
+                 *                and the array is left unchanged
+                 *
+                 *  Remark: Worst Case: O(n), as we may have to
+                 *          reallocate the buffer
+                 *
+                 *          Best Case: O(1), as the buffer size is
+                 *          large enough
+                 */
+
+
+                template <typename... Args>
+                    void emplace(size_t, Args&&...);
+                /*
+                 *  Description: Construct a new object at the
+                 *               specified index from the given
+                 *               constructor arguments and shift the
+                 *               existing objects to the right
+                 *
+                 *  Input: 1) Index at which the new object will be
+                 *            placed
+                 *         2) Arguments that are forwarded to one of
+                 *            the constructors of type <T>
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *                 2) Index has to be with in valid
+                 *                    range which is zero to size
+                 *
+                 *  Post-condition: 1) The new object is at the
+                 *                     specified index and the
+                 *                     objects following it are moved
+                 *                     one position to the right
+                 *
+                 *  Exception: 1) Throws OutOfMemory() if insufficient
+                 *                memory is available
+                 *             2) Throws InvalidIndexException()
+                 *                when the index is greater than
+                 *                the valid range (zero to size)
+                 *
+                 *  Remark: Worst Case: O(n), as we may have to
+                 *          reallocate the buffer or shift n objects
+                 *
+                 *          Best Case: O(1), when the index is equal
+                 *          to size and the buffer is large enough
+                 */
+
+
+                template <typename InputIt,
+                         typename = typename std::enable_if<
+                             !std::is_integral<InputIt>::value>::type>
+                    void append(InputIt, InputIt);
+                /*
+                 *  Description: Append copies of all the objects in
+                 *               the range [first, last) to the end
+                 *               of the array
+                 *
+                 *  Input: 1) Iterator to the first object to append
+                 *         2) Iterator one past the last object to
+                 *            append
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *                 2) The range does not refer to
+                 *                    objects of this array
+                 *
+                 *  Post-condition: 1) The objects are copy constructed
+                 *                     at the end of the array in the
+                 *                     same order as the range
+                 *                  2) If the range can be measured
+                 *                     (forward iterators) the buffer
+                 *                     is grown at most once
+                 *
+                 *  Exception: 1) OutOfMemory() exception will be
+                 *                thrown if we fail to get
+                 *                sufficient memory
+                 *             2) If a constructor throws, the objects
+                 *                appended so far are destroyed and
+                 *                the array keeps its old size
+                 *
+                 *  Remark: Best & Worst Case: O(n + m), where m is the
+                 *          length of the range, as we may have to
+                 *          reallocate once and construct m objects
+                 */
+
+
+                void append_n(size_t, const T&);
+                /*
+                 *  Description: Append the specified number of
+                 *               copies of the given value to the end
+                 *               of the array
+                 *
+                 *  Input: 1) Number of objects to append
+                 *         2) Value the new objects are copied from
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *
+                 *  Post-condition: 1) Size of Dynamic Array will be
+                 *                     incremented by the given count
+                 *                     and the buffer grown at most once
+                 *
+                 *  Exception: 1) OutOfMemory() exception will be
+                 *                thrown if we fail to get
+                 *                sufficient memory
+                 *             2) If a constructor throws, the objects
+                 *                appended so far are destroyed and
+                 *                the array keeps its old size
+                 *
+                 *  Remark: Best & Worst Case: O(n + m), where m is the
+                 *          number of objects appended
+                 */
+
+
+                template <typename InputIt,
+                         typename = typename std::enable_if<
+                             !std::is_integral<InputIt>::value>::type>
+                    void insert(size_t, InputIt, InputIt);
+                /*
+                 *  Description: Insert copies of all the objects in
+                 *               the range [first, last) at the
+                 *               specified index, in the same order
+                 *
+                 *  Input: 1) Index at which the first new object
+                 *            will be placed
+                 *         2) Iterator to the first object to insert
+                 *         3) Iterator one past the last object to
+                 *            insert
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) It is assumed that sufficient
+                 *                    memory is available
+                 *                 2) The range does not refer to
+                 *                    objects of this array
+                 *
+                 *  Post-condition: 1) The objects that were at index
+                 *                     and after are moved m positions
+                 *                     to the right, each of them
+                 *                     exactly once
+                 *                  2) The buffer is grown at most once
+                 *
+                 *  Exception: 1) Throws InvalidIndexException() when
+                 *                the index is greater than size
+                 *             2) Throws OutOfMemory() if insufficient
+                 *                memory is available
+                 *             3) If a constructor throws while the
+                 *                array grows the array is left
+                 *                unchanged, an exception of an
+                 *                assignment leaves every object valid
+                 *                but the order unspecified
+                 *
+                 *  Remark: Best & Worst Case: O(n + m), where m is the
+                 *          length of the range. An input range is
+                 *          first collected in a temporary array
+                 */
+
+
+                void insert(size_t, size_t, const T&);
+                /*
+                 *  Description: Insert the specified number of
+                 *               copies of the given value at the
+                 *               specified index
+                 *
+                 *  Input: 1) Index at which the first copy will be
+                 *            placed
+                 *         2) Number of copies to insert
+                 *         3) Value the new objects are copied from,
+                 *            it may be one of our own objects
+                 *
+                 *  Output: None
+                 *
+                 *  Exception: Same as insert(index, first, last)
+                 *
+                 *  Remark: Best & Worst Case: O(n + m), where m is the
+                 *          number of objects inserted
+                 */
+
+
+                void erase(size_t, size_t);
+                /*
+                 *  Description: Remove the objects from the first
+                 *               index up to but excluding the last
+                 *               index
+                 *
+                 *  Input: 1) Index of the first object to remove
+                 *         2) Index one past the last object to
+                 *            remove
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) first <= last <= size
+                 *
+                 *  Post-condition: 1) The objects following the
+                 *                     removed range are moved to the
+                 *                     left once, and the last
+                 *                     (last - first) objects are
+                 *                     destroyed
+                 *
+                 *  Exception: 1) InvalidIndexException() when the
+                 *                indices are not a valid range
+                 *
+                 *  Remark: Best & Worst Case: O(n - first)
+                 */
+
+
+                template <typename Predicate>
+                    size_t erase_if(Predicate);
+                /*
+                 *  Description: Remove every object for which the
+                 *               predicate returns true, keeping the
+                 *               order of the others
+                 *
+                 *  Input: 1) Function object taking a const T& and
+                 *            returning bool
+                 *
+                 *  Output: 1) Number of objects removed
+                 *
+                 *  Post-condition: 1) Every kept object is moved at
+                 *                     most once, the capacity is not
+                 *                     changed
+                 *
+                 *  Exception: 1) An exception of the predicate is
+                 *                passed on, every object is left
+                 *                valid but some may be moved-from
+                 *
+                 *  Remark: Best & Worst Case: O(n), a single pass
+                 *          instead of one remove() per object
+                 */
+
+
+                void remove(size_t index);
+                /*
+                 *  Description: Remove an object from the specified
+                 *               index
+                 *
+                 *  Input: 1) Index of the object that we want to
+                 *            remove from the array
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition: 1) Index has to be with in valid
+                 *                    range which is 0 to size-1
+                 *
+                 *  Post-condition: 1) The object at the specified
+                 *                     index will be removed and the
+                 *                     objects following it (if any)
+                 *                     will be shifted accordingly
+                 *                     to the left
+                 *
+                 *  Exception: 1) InvalidIndexException will be
+                 *                thrown if the index is not with in
+                 *                the valid range which is 0
                  *                to size-1
                  *
                  *  Remark: Worst Case: O(n), as we have to shift n
@@ -672,8 +1576,8 @@ namespace zh{
                  */
 
 
-                template <typename Y>
-                    DArray(const DArray<Y>&);
+                template <typename Y, typename P>
+                    DArray(const DArray<Y,P>&);
                 /*
                  *  Description: Create and initialize a dynamic 
                  *               array object of type <T> to 
@@ -694,6 +1598,9 @@ namespace zh{
                  *                 3) It is assumed that the type of 
                  *                 input Dynamic Array object that is
                  *                 passed is different from our own type
+                 *                 4) <Y> is not bool, DArray<bool>
+                 *                    holds bits (see bitdarray.hpp),
+                 *                    checked at compile time
                  *
                  *  Post-condition: 1) We create and initialize dynamic 
                  *                     array object from the given input 
@@ -703,13 +1610,17 @@ namespace zh{
                  *                  same state as the input object on a 
                  *                  logical level
                  *
-                 *  Exception: OutOfMemory() exception will be thrown if we 
-                 *             fail to get insufficient memory
-                 *
-                 *  Remark: Best and Worst case: O(n) as we need to create 
-                 *          a new dynamic array of size n and initialize 
-                 *          each object with value of the input dynamic 
-                 *          object
+                 *  Exception: 1) OutOfMemory() exception will be thrown
+                 *                if we fail to get sufficient memory
+                 *             2) An exception of the conversion is
+                 *                passed on after the objects built
+                 *                so far are destroyed
+                 *
+                 *  Remark: Best and Worst case: O(n), every object is
+                 *          constructed once directly from the object
+                 *          of the input array. Between arithmetic
+                 *          types (e.g. int to long) the conversion is
+                 *          a single loop the compiler vectorizes
                  */
 
 
@@ -762,10 +1673,17 @@ namespace zh{
                  *  Exception: 1) OutOfMemory() exception will be thrown 
                  *                if there is insufficient memory 
                  *                available
+                 *             2) If copying an object throws, the
+                 *                exception is passed on and the array
+                 *                is left exactly as it was
                  *
                  *  Remark: Worst Case: O(n), considering current buffer 
                  *          has to be reallocated and the existing 
-                 *          objects need to be copied onto new buffer
+                 *          objects need to be carried over to the new
+                 *          buffer. Trivially copyable objects are
+                 *          copied with a single memcpy, objects with
+                 *          a non-throwing move constructor are moved
+                 *          and only the remaining types are copied
                  *
                  *          Best Case: O(1), as the specified size is 
                  *          smaller than the existing physical size
@@ -775,14 +1693,85 @@ namespace zh{
                  */
 
 
+                void shrink_to_fit();
+                /*
+                 *  Description: Reduce the physical size of the array
+                 *               to its logical size, an empty array
+                 *               gives its heap back entirely
+                 *
+                 *  Input: None
+                 *
+                 *  Output: None
+                 *
+                 *  Post-condition: 1) capacity() == size()
+                 *                  2) Pointers and iterators to the
+                 *                     objects are invalidated if the
+                 *                     heap changed
+                 *
+                 *  Exception: 1) OutOfMemory() exception will be thrown
+                 *                if the smaller heap can't be
+                 *                allocated, the array is unchanged
+                 *             2) If copying an object throws, the
+                 *                exception is passed on and the array
+                 *                is left exactly as it was
+                 *
+                 *  Remark: Best & Worst Case: O(n), unless the array
+                 *          is already full
+                 */
+
+
+                bool trim(double = 0.5);
+                /*
+                 *  Description: Shrink the heap when less than the
+                 *               given ratio of it is in use, leaving
+                 *               the room GrowthPolicy::initial()
+                 *               gives for the current size
+                 *
+                 *  Input: 1) Utilization (size / capacity) below
+                 *            which the heap is shrunk
+                 *
+                 *  Output: 1) True if the heap was shrunk
+                 *
+                 *  Exception: Same as shrink_to_fit()
+                 *
+                 *  Remark: Meant to be called between requests of
+                 *          long running workers. Best case: O(1),
+                 *          worst case: O(n)
+                 */
+
+
+                MemoryResource* resource() const noexcept;
+                /*
+                 *  Description: Returns the memory resource that
+                 *               provides the heap of this array
+                 *
+                 *  Input: None
+                 *
+                 *  Output: The memory resource, newDeleteResource()
+                 *          unless another one was given to the
+                 *          constructor
+                 *
+                 *  Pre-condition: None
+                 *
+                 *  Post-condition: None
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: A copy of an array always uses
+                 *          newDeleteResource(), a moved array keeps
+                 *          the resource its buffer came from
+                 *
+                 *          Best & Worst Case: O(1)
+                 */
+
+
             private:
                 T* buffer;
                 size_t physicalSize; // Physical size
                 size_t logicalSize; // Logical size
                 unsigned char* myHeap;
+                MemoryResource* heapResource;
                 static const unsigned unitSize = sizeof(T);
-                static const size_t SIZE_DEFAULT = 5; 
-                static constexpr float PREALLOC_PERCENT = 1.50;
 
 
                 bool initObject(size_t, size_t, T*, const T& = T());
@@ -830,6 +1819,56 @@ namespace zh{
                  */
 
 
+                template <typename InputIt>
+                    void appendRange(InputIt, InputIt, 
+                            std::input_iterator_tag);
+
+                template <typename ForwardIt>
+                    void appendRange(ForwardIt, ForwardIt, 
+                            std::forward_iterator_tag);
+                /*
+                 *  Description: Helpers of append(first, last), an
+                 *               input range is appended one object
+                 *               at a time while a forward range is
+                 *               measured first so the buffer grows
+                 *               only once
+                 */
+
+
+                template <typename InputIt>
+                    void insertRange(size_t, InputIt, InputIt,
+                            std::input_iterator_tag);
+
+                template <typename ForwardIt>
+                    void insertRange(size_t, ForwardIt, ForwardIt,
+                            std::forward_iterator_tag);
+
+                template <typename ForwardIt>
+                    void insertCounted(size_t, ForwardIt, size_t);
+                /*
+                 *  Description: Helpers of insert(), an input range is
+                 *               collected in a temporary array first.
+                 *               insertCounted() inserts the given
+                 *               number of objects read from a forward
+                 *               iterator
+                 *
+                 *  Pre-condition: 1) index <= size
+                 */
+
+
+                void initAppended(size_t, const T&);
+                /*
+                 *  Description: Copy construct the specified number
+                 *               of objects after the last object and
+                 *               update the logical size
+                 *
+                 *  Pre-condition: 1) The buffer is large enough
+                 *
+                 *  Exception: 1) OutOfMemory() if initObject() fails,
+                 *                the logical size is not changed
+                 */
+
+
                 void initPhysicalSize(size_t);
                 /*
                  *  Description: Change physical size to the
@@ -842,15 +1881,11 @@ namespace zh{
                  *
                  *  Pre-condition:  None
                  *
-                 *  Post-condition: 1) If size is less than or equal 
-                 *                     to 5, physical size will be set 
-                 *                     to SIZE_DEFAULT which currently 
-                 *                     has value of 10
-                 *
-                 *                  2) If size is greatr
-                 *                     than 5, physical size
-                 *                     will be set to 1.5
-                 *                     times input size
+                 *  Post-condition: 1) Physical size is set to 
+                 *                     GrowthPolicy::initial() of the
+                 *                     input size, with DefaultGrowth
+                 *                     this is 5 for sizes up to 5 and
+                 *                     1.5 times input size otherwise
                  *
                  *  Exception: None
                  *
@@ -859,12 +1894,81 @@ namespace zh{
                  */
 
 
+                size_t growSize(size_t) const noexcept;
+                /*
+                 *  Description: Physical size to reallocate to so
+                 *               that at least the specified number
+                 *               of objects fit, as decided by 
+                 *               GrowthPolicy::grow()
+                 */
+
+
+                unsigned char* allocateHeap(size_t);
+                /*
+                 *  Description: Get room for the specified number of
+                 *               objects from our memory resource
+                 *
+                 *  Exception: 1) bad_alloc() if the resource fails
+                 */
+
+
+                void releaseHeap(unsigned char*, size_t) noexcept;
+                /*
+                 *  Description: Give a heap of the specified physical
+                 *               size back to our memory resource
+                 */
+
+
+                void reallocate(size_t);
+                /*
+                 *  Description: Move the objects to a new heap of
+                 *               exactly the specified physical size
+                 *               and release the old one
+                 *
+                 *  Pre-condition: 1) The specified size is at least
+                 *                    the logical size
+                 *
+                 *  Exception: 1) OutOfMemory() if the heap can't be
+                 *                allocated
+                 *             2) An exception of a copy constructor
+                 *                is passed on
+                 *             In both cases the array is unchanged
+                 */
+
+
+                void shrunk();
+
+                void shrunk(std::true_type) noexcept;
+
+                void shrunk(std::false_type) noexcept{}
+                /*
+                 *  Description: Called after objects have been
+                 *               removed, lets a growth policy with a
+                 *               shrink() function reduce the heap.
+                 *               Policies without one cost nothing
+                 *
+                 *  Exception: None, if the smaller heap can't be
+                 *             made the array keeps its current one
+                 */
+
+
+                void destroyObjects() noexcept;
+                /*
+                 *  Description: Run the destructor of every object
+                 *               and set the logical size to zero.
+                 *               Unlike clear() the growth policy is
+                 *               not asked to shrink, the destructor
+                 *               and move assignment give the heap
+                 *               back right after
+                 */
+
+
                 void cleanHeap();
                 /*
-                 *  Description: Delete and free myHeap and make sure 
-                 *               the pointers myHeap and buffer are 
-                 *               set to nullptr to prevent accidental 
-                 *               usage
+                 *  Description: Give myHeap back to our memory resource
+                 *               and make sure the pointers myHeap
+                 *               and buffer are set to nullptr to
+                 *               prevent accidental usage
                  *
                  *  Input:  None 
                  *
@@ -896,23 +2000,42 @@ namespace zh{
     //============================================||
 
 
-    template <typename T>
-        DArray<T>::DArray(): logicalSize(0), physicalSize(0), 
-        buffer(nullptr), myHeap(nullptr){
+    template <typename T, typename G>
+        DArray<T,G>::DArray(): logicalSize(0), physicalSize(0), 
+        buffer(nullptr), myHeap(nullptr), 
+        heapResource(newDeleteResource()){
+
+            try{
+                initPhysicalSize(0);
+                myHeap = allocateHeap(physicalSize); 
+                buffer = reinterpret_cast<T*>(myHeap);
+            }catch (bad_alloc){
+                physicalSize = 0;
+                throw OutOfMemory();
+            }
+        }
+
+
+    template <typename T, typename G>
+        DArray<T,G>::DArray(MemoryResource& source): logicalSize(0), 
+        physicalSize(0), buffer(nullptr), myHeap(nullptr), 
+        heapResource(&source){
 
             try{
-                myHeap = new unsigned char[SIZE_DEFAULT*unitSize]; 
+                initPhysicalSize(0);
+                myHeap = allocateHeap(physicalSize); 
                 buffer = reinterpret_cast<T*>(myHeap);
-                physicalSize = SIZE_DEFAULT;
             }catch (bad_alloc){
+                physicalSize = 0;
                 throw OutOfMemory();
             }
         }
 
 
-    template <typename T>
-        DArray<T>::DArray(size_t inputSize): 
-            logicalSize(inputSize), buffer(nullptr), myHeap(nullptr){
+    template <typename T, typename G>
+        DArray<T,G>::DArray(size_t inputSize): 
+            logicalSize(inputSize), buffer(nullptr), myHeap(nullptr),
+            heapResource(newDeleteResource()){
 
                 // Setting the correct physical size
                 initPhysicalSize(inputSize);
@@ -920,7 +2043,7 @@ namespace zh{
                 // We try to get the required memory on heap
                 // and make buffer point to the same thing
                 try{
-                    myHeap = new unsigned char[physicalSize * unitSize]; 
+                    myHeap = allocateHeap(physicalSize); 
                     buffer = reinterpret_cast<T*>(myHeap);
                 }catch (bad_alloc){
                     physicalSize = logicalSize = 0;
@@ -939,15 +2062,16 @@ namespace zh{
             }
 
 
-    template <typename T>
-        DArray<T>::DArray(size_t inputSize, const T& input):
-            logicalSize(inputSize), buffer(nullptr), myHeap(nullptr){
+    template <typename T, typename G>
+        DArray<T,G>::DArray(size_t inputSize, const T& input):
+            logicalSize(inputSize), buffer(nullptr), myHeap(nullptr),
+            heapResource(newDeleteResource()){
 
                 initPhysicalSize(inputSize);
 
                 // Trying to get sufficient memory
                 try{
-                    myHeap = new unsigned char[physicalSize*unitSize];
+                    myHeap = allocateHeap(physicalSize);
                     buffer = reinterpret_cast<T*>(myHeap);
                 }catch (bad_alloc){
                     physicalSize = logicalSize = 0;
@@ -966,37 +2090,152 @@ namespace zh{
             }
 
 
-    template <typename T>
-        DArray<T>::~DArray() noexcept{
-            clear();
-            cleanHeap();
-        }
-
-
-    template <typename T>
-        DArray<T>::DArray(const DArray<T>& copy): buffer(nullptr), 
-        myHeap(nullptr), logicalSize(0), physicalSize(0){
-            *this = copy;
-        }
-
+    template <typename T, typename G>
+        DArray<T,G>::DArray(size_t inputSize, const T& input, 
+                MemoryResource& source):
+            logicalSize(inputSize), buffer(nullptr), myHeap(nullptr),
+            heapResource(&source){
 
-    template <typename T>
-        DArray<T>& DArray<T>::operator=(const DArray<T>& rhs) {
-            if (this != &rhs){
+                initPhysicalSize(inputSize);
+
+                // Trying to get sufficient memory
+                try{
+                    myHeap = allocateHeap(physicalSize);
+                    buffer = reinterpret_cast<T*>(myHeap);
+                }catch (bad_alloc){
+                    physicalSize = logicalSize = 0;
+                    throw OutOfMemory();   
+                }
+
+                // Creating and initializing objects on
+                // logical size section of the memory
+                bool status = initObject(0, logicalSize, buffer, input);
+
+                if (status == false){
+                    logicalSize = 0;
+                    cleanHeap();
+                    throw OutOfMemory();
+                }
+            }
+
+
+    template <typename T, typename G>
+        DArray<T,G>::~DArray() noexcept{
+            destroyObjects();
+            cleanHeap();
+        }
+
+
+    template <typename T, typename G>
+        DArray<T,G>::DArray(const DArray<T,G>& copy): buffer(nullptr), 
+        physicalSize(0), logicalSize(0), myHeap(nullptr), 
+        heapResource(newDeleteResource()){
+
+            // Every object is copy constructed once, instead of
+            // being default constructed and then assigned
+            initPhysicalSize(copy.logicalSize);
+
+            try{
+                myHeap = allocateHeap(physicalSize);
+                buffer = reinterpret_cast<T*>(myHeap);
+            }catch (bad_alloc){
+                physicalSize = 0;
+                throw OutOfMemory();
+            }
+
+            try{
+                detail::convert(copy.buffer, buffer, copy.logicalSize);
+            }catch (bad_alloc){
+                cleanHeap();
+                throw OutOfMemory();
+            }catch (...){
+                cleanHeap();
+                throw;
+            }
+
+            logicalSize = copy.logicalSize;
+            ZH_COUNT(copied(this, logicalSize));
+        }
+
+
+    template <typename T, typename G>
+        DArray<T,G>& DArray<T,G>::operator=(const DArray<T,G>& rhs) {
+            if (this != &rhs){
 
                 resize(rhs.size(), T());
 
                 for (size_t i=0; i < logicalSize; ++i){
                     *(buffer+i) = *(rhs.buffer+i);
                 }
+
+                ZH_COUNT(copied(this, logicalSize));
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, typename G>
+        DArray<T,G>::DArray(DArray<T,G>&& other) noexcept: 
+            buffer(other.buffer), physicalSize(other.physicalSize),
+            logicalSize(other.logicalSize), myHeap(other.myHeap),
+            heapResource(other.heapResource){
+
+                // The input object keeps no buffer at all, its
+                // destructor will then have nothing to clean up
+                other.buffer = nullptr;
+                other.myHeap = nullptr;
+                other.physicalSize = other.logicalSize = 0;
+            }
+
+
+    template <typename T, typename G>
+        DArray<T,G>& DArray<T,G>::operator=(DArray<T,G>&& rhs) noexcept{
+            if (this != &rhs){
+                destroyObjects();
+                cleanHeap();
+
+                // The buffer can only be given back to the
+                // resource it came from, so it comes with us
+                heapResource = rhs.heapResource;
+                buffer = rhs.buffer;
+                myHeap = rhs.myHeap;
+                physicalSize = rhs.physicalSize;
+                logicalSize = rhs.logicalSize;
+
+                rhs.buffer = nullptr;
+                rhs.myHeap = nullptr;
+                rhs.physicalSize = rhs.logicalSize = 0;
             }
 
             return *this;
         }
 
 
-    template <typename T>
-        const T& DArray<T>::operator[](size_t index) const{
+    template <typename T, typename G>
+        inline const T& DArray<T,G>::operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize, "DArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, typename G>
+        inline T& DArray<T,G>::operator[](size_t index) {
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize, "DArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, typename G>
+        const T& DArray<T,G>::at(size_t index) const{
             if (index < logicalSize){
                 return *(buffer+index);
             }else{
@@ -1005,8 +2244,8 @@ namespace zh{
         }
 
 
-    template <typename T>
-        T& DArray<T>::operator[](size_t index) {
+    template <typename T, typename G>
+        T& DArray<T,G>::at(size_t index) {
             if (index < logicalSize){
                 return *(buffer+index);
             }else{
@@ -1015,12 +2254,12 @@ namespace zh{
         }
 
 
-    template <typename T>
-        void DArray<T>::resize(size_t inputSize, const T& value){
+    template <typename T, typename G>
+        void DArray<T,G>::resize(size_t inputSize, const T& value){
             if (inputSize > logicalSize){
 
                 if (inputSize > physicalSize){
-                    reserve((inputSize * PREALLOC_PERCENT));
+                    reserve(growSize(inputSize));
                 }
 
                 // Initializing new objects on buffer 
@@ -1037,22 +2276,19 @@ namespace zh{
                 logicalSize = inputSize;
 
             }else{
-
-                while (logicalSize != inputSize){
-                    remove_last();
-                }
+                erase(inputSize, logicalSize);
             }
         }
 
 
-    template <typename T>
-        inline size_t DArray<T>::size() const noexcept{
+    template <typename T, typename G>
+        inline size_t DArray<T,G>::size() const noexcept{
             return logicalSize;
         }
 
 
-    template <typename T>
-        inline bool DArray<T>::isEmpty() const noexcept{
+    template <typename T, typename G>
+        inline bool DArray<T,G>::isEmpty() const noexcept{
             if (logicalSize == 0){
                 return true;
             }else{
@@ -1061,55 +2297,335 @@ namespace zh{
         }
 
 
-    template <typename T>
-        void DArray<T>::clear(){
-            for (size_t i=0; i < logicalSize; ++i){
-                (&buffer[i])->~T();
+    template <typename T, typename G>
+        void DArray<T,G>::clear(){
+            destroyObjects();
+            shrunk();
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::add(const T& value, size_t index){
+            if (index > size()){
+                throw InvalidIndexException();
+            }else{
+                emplace(index, value);
             }
+        }
 
-            logicalSize = 0;
+
+    template <typename T, typename G>
+        void DArray<T,G>::append(const T& value){
+            emplace_back(value);
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::add(T&& value, size_t index){
+            emplace(index, std::move(value));
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::append(T&& value){
+            emplace_back(std::move(value));
+        }
+
+
+    template <typename T, typename G>
+        template <typename... Args>
+        void DArray<T,G>::emplace_back(Args&&... args){
+            if (logicalSize < physicalSize){
+                try{
+                    new (buffer + logicalSize) T(std::forward<Args>(args)...);
+                }catch (bad_alloc){
+                    throw OutOfMemory();
+                }
+            }else{
+                // The arguments may refer to one of our own
+                // objects, so the new object is built before
+                // reserve() releases the old buffer
+                T item(std::forward<Args>(args)...);
+                reserve(growSize(logicalSize+1));
+
+                try{
+                    new (buffer + logicalSize) T(std::move(item));
+                }catch (bad_alloc){
+                    throw OutOfMemory();
+                }
+            }
+
+            ++logicalSize;
         }
 
 
-    template <typename T>
-        void DArray<T>::add(const T& value, size_t index){
+    template <typename T, typename G>
+        template <typename... Args>
+        void DArray<T,G>::emplace(size_t index, Args&&... args){
             if (index > size()){
                 throw InvalidIndexException();
+            }else if (index == size()){
+                emplace_back(std::forward<Args>(args)...);
             }else{
-                resize(size()+1, T());
+                T item(std::forward<Args>(args)...);
+
+                // The last object is moved into the free slot
+                // first, then the rest is shifted by assignment
+                emplace_back(std::move(*(buffer+logicalSize-1)));
 
-                for (size_t i=size(); i>index; i--){
-                    *(buffer+i) = *(buffer+i-1);
+                for (size_t i=logicalSize-2; i>index; i--){
+                    *(buffer+i) = std::move(*(buffer+i-1));
                 }
 
-                *(buffer+index) = value;
+                *(buffer+index) = std::move(item);
             }
         }
 
 
-    template <typename T>
-        void DArray<T>::append(const T& value){
-            add(value, size());
+    template <typename T, typename G>
+        template <typename InputIt, typename>
+        void DArray<T,G>::append(InputIt first, InputIt last){
+            appendRange(first, last, typename 
+                    std::iterator_traits<InputIt>::iterator_category());
         }
 
 
-    template <typename T>
-        void DArray<T>::remove(size_t index){
-            if (index >= size()){
-                throw InvalidIndexException();
+    template <typename T, typename G>
+        void DArray<T,G>::append_n(size_t count, const T& value){
+            if (count == 0){
+                return;
+            }
+
+            if (logicalSize + count > physicalSize){
+                // value may be one of our own objects
+                T item(value);
+                reserve(growSize(logicalSize + count));
+                initAppended(count, item);
             }else{
+                initAppended(count, value);
+            }
+        }
+
+
+    template <typename T, typename G>
+        template <typename InputIt, typename>
+        void DArray<T,G>::insert(size_t index, InputIt first, InputIt last){
+            if (index > size()){
+                throw InvalidIndexException();
+            }
+
+            insertRange(index, first, last, typename 
+                    std::iterator_traits<InputIt>::iterator_category());
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::insert(size_t index, size_t count, const T& value){
+            if (index > size()){
+                throw InvalidIndexException();
+            }
+
+            // value may be one of the objects we are about to move
+            T item(value);
+            insertCounted(index, detail::RepeatIterator<T>(item, 0), count);
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::erase(size_t first, size_t last){
+            if (first > last || last > size()){
+                throw InvalidIndexException();
+            }
+
+            if (first == last){
+                return;
+            }
+
+            std::move(buffer + last, buffer + logicalSize, buffer + first);
+
+            size_t newSize = logicalSize - (last - first);
+
+            while (logicalSize > newSize){
+                --logicalSize;
+                (&buffer[logicalSize])->~T();
+            }
+
+            shrunk();
+        }
+
+
+    template <typename T, typename G>
+        template <typename Predicate>
+        size_t DArray<T,G>::erase_if(Predicate predicate){
+            size_t kept = 0;
+
+            for (size_t i=0; i < logicalSize; i++){
+                if (!predicate(static_cast<const T&>(buffer[i]))){
+                    if (kept != i){
+                        *(buffer+kept) = std::move(*(buffer+i));
+                    }
+                    ++kept;
+                }
+            }
 
-                for (size_t i=index; i < size()-1; i++){
-                    *(buffer+i) = *(buffer+i+1);
+            size_t removed = logicalSize - kept;
+
+            while (logicalSize > kept){
+                --logicalSize;
+                (&buffer[logicalSize])->~T();
+            }
+
+            if (removed > 0){
+                shrunk();
+            }
+
+            return removed;
+        }
+
+
+    template <typename T, typename G>
+        template <typename InputIt>
+        void DArray<T,G>::insertRange(size_t index, InputIt first,
+                InputIt last, std::input_iterator_tag){
+            // A single pass range can't be measured, collect it
+            // and move the objects in from the copy
+            DArray<T,G> items;
+            items.append(first, last);
+            insertCounted(index, std::make_move_iterator(items.begin()),
+                    items.size());
+        }
+
+
+    template <typename T, typename G>
+        template <typename ForwardIt>
+        void DArray<T,G>::insertRange(size_t index, ForwardIt first,
+                ForwardIt last, std::forward_iterator_tag){
+            insertCounted(index, first, std::distance(first, last));
+        }
+
+
+    template <typename T, typename G>
+        template <typename ForwardIt>
+        void DArray<T,G>::insertCounted(size_t index, ForwardIt first,
+                size_t count){
+            if (count == 0){
+                return;
+            }
+
+            if (logicalSize + count > physicalSize){
+                reserve(growSize(logicalSize + count));
+            }
+
+            size_t oldSize = logicalSize;
+            size_t front = std::min(count, oldSize - index);
+
+            // 1) Construct the slots past the old end, they receive
+            //    the last objects of the tail or, when the range is
+            //    longer than the tail, its last objects. Undone if a
+            //    constructor throws
+            ForwardIt spill = std::next(first, front);
+            size_t i = oldSize;
+
+            try{
+                for (; i < oldSize + count; i++){
+                    if (i >= index + count){
+                        new (buffer + i) T(std::move_if_noexcept(
+                                    *(buffer + i - count)));
+                    }else{
+                        new (buffer + i) T(*spill);
+                        ++spill;
+                    }
+                }
+            }catch (bad_alloc){
+                while (i > oldSize){
+                    --i;
+                    (&buffer[i])->~T();
                 }
+                throw OutOfMemory();
+            }catch (...){
+                while (i > oldSize){
+                    --i;
+                    (&buffer[i])->~T();
+                }
+                throw;
+            }
+
+            logicalSize = oldSize + count;
+
+            // 2) Shift the rest of the tail right, back to front
+            for (i = oldSize - front; i > index; i--){
+                *(buffer+i-1+count) = std::move(*(buffer+i-1));
+            }
 
-                remove_last();
+            // 3) Assign the first objects of the range
+            for (i = index; i < index + front; i++, ++first){
+                *(buffer+i) = *first;
             }
         }
 
 
-    template <typename T>
-        void DArray<T>::remove_last(){
+    template <typename T, typename G>
+        template <typename InputIt>
+        void DArray<T,G>::appendRange(InputIt first, InputIt last,
+                std::input_iterator_tag){
+            for (; first != last; ++first){
+                emplace_back(*first);
+            }
+        }
+
+
+    template <typename T, typename G>
+        template <typename ForwardIt>
+        void DArray<T,G>::appendRange(ForwardIt first, ForwardIt last,
+                std::forward_iterator_tag){
+            size_t count = std::distance(first, last);
+
+            if (logicalSize + count > physicalSize){
+                reserve(growSize(logicalSize + count));
+            }
+
+            size_t i = logicalSize;
+
+            try{
+                for (; first != last; ++first, ++i){
+                    new (buffer + i) T(*first);
+                }
+            }catch (...){
+                while (i > logicalSize){
+                    --i;
+                    (&buffer[i])->~T();
+                }
+                throw;
+            }
+
+            logicalSize = i;
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::initAppended(size_t count, const T& value){
+            // initObject() rolls back what it built on failure
+            if (initObject(logicalSize, logicalSize + count, 
+                        buffer, value) == false){
+                throw OutOfMemory();
+            }
+
+            logicalSize += count;
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::remove(size_t index){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }else{
+                erase(index, index + 1);
+            }
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::remove_last(){
             if (isEmpty()){
                 throw ArrayEmpty();
             }else {
@@ -1119,12 +2635,13 @@ namespace zh{
                 // logicalSize-1
                 --logicalSize;
                 (&buffer[logicalSize])->~T();
+                shrunk();
             }
         }
 
 
-    template <typename T>
-        bool DArray<T>::initObject(size_t startIndex,
+    template <typename T, typename G>
+        bool DArray<T,G>::initObject(size_t startIndex,
                 size_t endIndex, T* inputBuffer, 
                 const T& inputValue){
 
@@ -1153,8 +2670,9 @@ namespace zh{
                 }
 
             }catch (bad_alloc){
-                // Cleanup phase
-                for(; i > 0; --i){
+                // Cleanup phase, only the objects we created
+                while (i > startIndex){
+                    --i;
                     (&inputBuffer[i])->~T();
                 }
                 return false;
@@ -1164,109 +2682,200 @@ namespace zh{
         }
 
 
-    template <typename T>
-        void DArray<T>::initPhysicalSize(size_t inputSize){
-            if (inputSize <= 5){
-                physicalSize =  SIZE_DEFAULT;
-            }else{
-                physicalSize = inputSize*PREALLOC_PERCENT;
+    template <typename T, typename G>
+        void DArray<T,G>::initPhysicalSize(size_t inputSize){
+            physicalSize = G::initial(inputSize);
+        }
+
+
+    template <typename T, typename G>
+        inline size_t DArray<T,G>::growSize(size_t required) const noexcept{
+            return G::grow(physicalSize, required);
+        }
+
+
+    template <typename T, typename G>
+        inline unsigned char* DArray<T,G>::allocateHeap(size_t count){
+            unsigned char* heap = static_cast<unsigned char*>(
+                    heapResource->allocate(count * unitSize, alignof(T)));
+
+            ZH_COUNT(allocated(this, count * unitSize, count));
+            return heap;
+        }
+
+
+    template <typename T, typename G>
+        inline void DArray<T,G>::releaseHeap(unsigned char* heap, 
+                size_t count) noexcept{
+            if (heap != nullptr){
+                heapResource->deallocate(heap, count * unitSize, alignof(T));
+                ZH_COUNT(released(this, count * unitSize));
             }
         }
 
 
-    template <typename T>
-        void DArray<T>::cleanHeap(){
-            delete [] myHeap;
+    template <typename T, typename G>
+        void DArray<T,G>::destroyObjects() noexcept{
+            for (size_t i=0; i < logicalSize; ++i){
+                (&buffer[i])->~T();
+            }
+
+            logicalSize = 0;
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::cleanHeap(){
+            releaseHeap(myHeap, physicalSize);
             buffer = nullptr;
             myHeap = nullptr;
             physicalSize = 0;
         }
 
 
-    template <typename T>
-        size_t DArray<T>::capacity() const{
+    template <typename T, typename G>
+        size_t DArray<T,G>::capacity() const{
             return physicalSize;
         }
 
 
-    template <typename T>
-        void DArray<T>::reserve(size_t inputSize) {
+    template <typename T, typename G>
+        inline MemoryResource* DArray<T,G>::resource() const noexcept{
+            return heapResource;
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::reserve(size_t inputSize) {
             if (inputSize > physicalSize){
-                size_t newSize = inputSize;
-                T* oldBuffer = buffer;
-                unsigned char* oldHeap = myHeap;
+                reallocate(inputSize);
+            }
+        }
 
-                try{
-                    myHeap = new unsigned char[newSize * unitSize];
-                    buffer = reinterpret_cast<T*>(myHeap);
-                } catch (bad_alloc){
-                    myHeap = oldHeap;
-                    throw OutOfMemory();
-                }
 
-                size_t i = 0;
+    template <typename T, typename G>
+        void DArray<T,G>::reallocate(size_t newSize){
+            unsigned char* newHeap = nullptr;
 
-                try{
-                    for(; i < logicalSize; ++i){
-                        new (buffer + i) T(*(oldBuffer+i));
-                    }
+            try{
+                newHeap = allocateHeap(newSize);
+            } catch (bad_alloc){
+                throw OutOfMemory();
+            }
 
-                } catch (bad_alloc){
-                    // Cleanup phase
-                    for(; i > 0; --i){
-                        (&buffer[i])->~T();
-                    }
-                    delete [] myHeap;
-                    myHeap = oldHeap;
-                    buffer = oldBuffer;
-                    throw;
-                }
+            // On failure relocate() has already destroyed
+            // what it built, the old buffer is untouched
+            try{
+                detail::relocate(buffer, 
+                        reinterpret_cast<T*>(newHeap), logicalSize);
+            } catch (bad_alloc){
+                releaseHeap(newHeap, newSize);
+                throw OutOfMemory();
+            } catch (...){
+                releaseHeap(newHeap, newSize);
+                throw;
+            }
 
-                // Cleaning up old buffer
-                for (size_t j=0; j < logicalSize; ++j){
-                    (&oldBuffer[j])->~T();
-                }
+            ZH_COUNT(relocated<T>(this, logicalSize));
+            releaseHeap(myHeap, physicalSize);
+            myHeap = newHeap;
+            buffer = reinterpret_cast<T*>(myHeap);
+            physicalSize = newSize;
+        }
+
+
+    template <typename T, typename G>
+        void DArray<T,G>::shrink_to_fit(){
+            if (physicalSize == logicalSize){
+                return;
+            }
+
+            if (logicalSize == 0){
+                cleanHeap();
+            }else{
+                reallocate(logicalSize);
+            }
+        }
+
+
+    template <typename T, typename G>
+        bool DArray<T,G>::trim(double ratio){
+            if (static_cast<double>(logicalSize) >= 
+                    ratio * static_cast<double>(physicalSize)){
+                return false;
+            }
+
+            size_t target = G::initial(logicalSize);
+
+            if (target >= physicalSize){
+                return false;
+            }
 
-                delete [] oldHeap;
-                physicalSize = newSize;
+            reallocate(target);
+            return true;
+        }
+
+
+    template <typename T, typename G>
+        inline void DArray<T,G>::shrunk(){
+            shrunk(detail::HasShrink<G>());
+        }
 
+
+    template <typename T, typename G>
+        void DArray<T,G>::shrunk(std::true_type) noexcept{
+            size_t target = G::shrink(physicalSize, logicalSize);
+
+            if (target < physicalSize && target >= logicalSize){
+                try{
+                    reallocate(target);
+                }catch (...){
+                    // Keeping the larger heap is always correct
+                }
             }
         }
 
-    template <typename T>
-        template <typename Y>
-        DArray<T>::DArray(const DArray<Y>& input): 
-            buffer(nullptr), myHeap(nullptr)    
+    template <typename T, typename G>
+        template <typename Y, typename P>
+        DArray<T,G>::DArray(const DArray<Y,P>& input): 
+            buffer(nullptr), myHeap(nullptr), 
+            heapResource(newDeleteResource())
     {
+        static_assert(!std::is_same<Y, bool>::value, "DArray<bool> "
+                "holds bits and can't be converted, append its flags "
+                "one by one");
+
         logicalSize = input.size(); 
         initPhysicalSize(logicalSize); 
 
         try{
-            myHeap = new unsigned char[physicalSize * unitSize]; 
+            myHeap = allocateHeap(physicalSize); 
             buffer = reinterpret_cast<T*>(myHeap);
         }catch (bad_alloc){
             physicalSize = logicalSize = 0;
             throw OutOfMemory();
         }
 
-        // Creating and initializing objects of
-        // type <T> on our buffer
-        bool status = initObject(0, logicalSize, buffer, T());
-
-        if (status == false){
+        try{
+            detail::convert(input.begin(), buffer, logicalSize);
+        }catch (bad_alloc){
             logicalSize = 0;
             cleanHeap();
             throw OutOfMemory();
+        }catch (...){
+            logicalSize = 0;
+            cleanHeap();
+            throw;
         }
 
-        // Copying exact values
-        for (size_t i=0; i < logicalSize; ++i){
-            *(buffer+i) = static_cast<T>(input[i]);
-        }
+        ZH_COUNT(copied(this, logicalSize));
     }
 
 } // namespace zh
 
+// Bit-packed DArray<bool>, must follow the primary template
+#include "bitdarray.hpp"
+
 #endif /* ifndef DARRAY */
 
 
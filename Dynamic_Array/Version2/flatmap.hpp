@@ -0,0 +1,1097 @@
+/*
+ * Filename:      flatmap.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (08:30 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef FLATMAP
+#define FLATMAP
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+
+namespace zh{
+
+
+    namespace detail{
+
+        // DArray<bool> packs its flags into bits and has no bool& to
+        // hand out, so FlatMap keeps bool values in one byte
+        // wrappers instead, which FlatMap hands out in place of bool&
+
+        struct FlatBool{
+            bool value;
+
+            FlatBool(bool input = false) noexcept: value(input){}
+
+            operator bool() const noexcept{
+                return value;
+            }
+        };
+
+        template <typename V>
+            struct FlatValue{
+                typedef V type;
+            };
+
+        template <>
+            struct FlatValue<bool>{
+                typedef FlatBool type;
+            };
+
+
+        // Sorted key search shared by FlatSet and FlatMap.
+        //
+        // lowerBound() halves the range without a branch on the
+        // comparison (it becomes a conditional move), so a lookup
+        // costs no mispredictions. An EytzingerIndex stores the
+        // keys once more in breadth first order: the two children
+        // of node k are 2k and 2k+1, the first levels share a few
+        // cache lines and the next nodes can be prefetched.
+
+        template <typename K, typename C>
+            size_t lowerBound(const K* keys, size_t count, const K& key,
+                    const C& less){
+                if (count == 0){
+                    return 0;
+                }
+
+                const K* base = keys;
+
+                while (count > 1){
+                    size_t half = count / 2;
+                    base = less(base[half], key) ? base + half : base;
+                    count -= half;
+                }
+
+                return static_cast<size_t>(base - keys) +
+                    (less(*base, key) ? 1 : 0);
+            }
+
+
+        template <typename K, typename C>
+            class EytzingerIndex{
+                public:
+                    EytzingerIndex() noexcept: count(0){}
+
+                    void build(const DArray<K>& sorted);
+                    /*
+                     *  Description: Lay out the sorted keys in
+                     *               breadth first order
+                     *
+                     *  Exception: 1) OutOfMemory() if the layout
+                     *                can't be allocated, the index
+                     *                is then left empty
+                     *
+                     *  Remark: Best & Worst case: O(n)
+                     */
+
+
+                    void clear() noexcept;
+
+                    bool isBuilt() const noexcept{
+                        return !ranks.isEmpty();
+                    }
+
+
+                    size_t lowerBound(const K&, const C&) const;
+                    /*
+                     *  Description: Returns the position in the
+                     *               sorted keys of the first key not
+                     *               less than the given one, or the
+                     *               number of keys if there is none
+                     *
+                     *  Remark: Best & Worst case: O(log n)
+                     */
+
+
+                private:
+                    DArray<K> nodes;        // nodes[0] is unused
+                    DArray<size_t> ranks;   // Sorted position of node k
+                    size_t count;
+
+                    size_t fill(size_t, size_t) noexcept;
+            };
+
+
+        template <typename K, typename C>
+            void EytzingerIndex<K,C>::build(const DArray<K>& sorted){
+                clear();
+
+                if (sorted.isEmpty()){
+                    return;
+                }
+
+                try{
+                    count = sorted.size();
+                    ranks.resize(count + 1, 0);
+                    fill(0, 1);
+
+                    nodes.reserve(count + 1);
+                    nodes.append(sorted[0]);
+
+                    for (size_t k=1; k <= count; ++k){
+                        nodes.append(sorted[ranks[k]]);
+                    }
+                }catch (...){
+                    clear();
+                    throw;
+                }
+            }
+
+
+        template <typename K, typename C>
+            void EytzingerIndex<K,C>::clear() noexcept{
+                nodes.clear();
+                ranks.clear();
+                count = 0;
+            }
+
+
+        template <typename K, typename C>
+            size_t EytzingerIndex<K,C>::fill(size_t next, size_t node)
+            noexcept{
+                // In order walk of the implicit tree, the recursion
+                // is only as deep as the tree (log n)
+                if (node <= count){
+                    next = fill(next, 2 * node);
+                    ranks[node] = next++;
+                    next = fill(next, 2 * node + 1);
+                }
+
+                return next;
+            }
+
+
+        template <typename K, typename C>
+            size_t EytzingerIndex<K,C>::lowerBound(const K& key,
+                    const C& less) const{
+                const K* tree = nodes.begin();
+                size_t node = 1;
+
+                while (node <= count){
+#ifdef __GNUC__
+                    // The 16 nodes four levels down are contiguous
+                    __builtin_prefetch(tree +
+                            ((node << 4) <= count ? (node << 4) : 0));
+#endif
+                    node = 2 * node + (less(tree[node], key) ? 1 : 0);
+                }
+
+                // Undo the right turns taken after the last left
+                // turn, that node is the lower bound
+                node >>= __builtin_ffsll(
+                        static_cast<long long>(~node));
+
+                return node == 0 ? count : ranks.begin()[node];
+            }
+
+
+        template <typename T, typename KeyOf, typename C>
+            void dropDuplicates(DArray<T>& items, KeyOf keyOf,
+                    const C& less){
+                // One pass over sorted items, the first of equal
+                // keys is kept
+                size_t length = items.size();
+
+                if (length < 2){
+                    return;
+                }
+
+                size_t last = 0;
+
+                for (size_t i=1; i < length; ++i){
+                    if (less(keyOf(items[last]), keyOf(items[i]))){
+                        ++last;
+
+                        if (last != i){
+                            items[last] = std::move(items[i]);
+                        }
+                    }
+                }
+
+                items.erase(last + 1, length);
+            }
+
+    } // namespace detail
+
+
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename K, typename Compare = std::less<K> >
+        class FlatSet{
+
+            /*  // Summary of available services
+             *
+             *  Set of unique keys kept sorted in one DArray. A lookup
+             *  is a branchless binary search over contiguous memory,
+             *  or after buildIndex() a search of an Eytzinger copy of
+             *  the keys. Inserting one key is O(n), build large sets
+             *  from a range or add keys in batches instead.
+             *
+             *  FlatSet();
+             *
+             *  explicit FlatSet(Compare);
+             *
+             *  template <typename InputIt>
+             *      FlatSet(InputIt, InputIt, Compare = Compare());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void reserve(size_t);
+             *
+             *  bool insert(const K&);
+             *
+             *  template <typename InputIt>
+             *      size_t insert(InputIt, InputIt);
+             *
+             *  bool erase(const K&);
+             *
+             *  bool contains(const K&) const;
+             *
+             *  const K* find(const K&) const;
+             *
+             *  const K* lower_bound(const K&) const;
+             *
+             *  void buildIndex();
+             *
+             *  bool hasIndex() const;
+             */
+
+            public:
+                // Keys can't be changed in place, they would no
+                // longer be sorted
+                typedef const K* iterator;
+                typedef const K* const_iterator;
+
+                const_iterator begin() const{ return keys.begin();};
+                const_iterator end() const{ return keys.end();};
+
+                FlatSet();
+
+                explicit FlatSet(Compare);
+
+
+                template <typename InputIt>
+                    FlatSet(InputIt, InputIt, Compare = Compare());
+                /*
+                 *  Description: Build the set from unsorted keys that
+                 *               may repeat: the keys are sorted once
+                 *               and duplicates dropped in one pass
+                 *
+                 *  Exception: 1) OutOfMemory() if the keys can't be
+                 *                stored
+                 *
+                 *  Remark: Best & Worst case: O(n log n), much less
+                 *          than n inserts of O(n) each
+                 */
+
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+
+                void reserve(size_t);
+
+
+                bool insert(const K&);
+                /*
+                 *  Description: Add a key if the set doesn't hold it
+                 *
+                 *  Output: 1) true if the key was added
+                 *
+                 *  Remark: Worst case: O(n), the keys after it move
+                 */
+
+
+                template <typename InputIt>
+                    size_t insert(InputIt, InputIt);
+                /*
+                 *  Description: Add a batch of unsorted keys: the
+                 *               batch is sorted and merged with the
+                 *               set in one pass
+                 *
+                 *  Output: 1) Number of keys added
+                 *
+                 *  Exception: 1) OutOfMemory() if the merged keys
+                 *                can't be stored, the set is unchanged
+                 *
+                 *  Remark: Best & Worst case: O(n + m log m) for m
+                 *          keys, against O(n * m) for m inserts
+                 */
+
+
+                bool erase(const K&);
+                /*
+                 *  Output: 1) true if the key was in the set
+                 */
+
+
+                bool contains(const K&) const;
+
+                const K* find(const K&) const;
+                /*
+                 *  Description: Returns the key of the set equal to
+                 *               the given one, or end() if there is
+                 *               none
+                 *
+                 *  Remark: Best & Worst case: O(log n)
+                 */
+
+
+                const K* lower_bound(const K&) const;
+                /*
+                 *  Description: Returns the first key not less than
+                 *               the given one, or end()
+                 */
+
+
+                void buildIndex();
+                /*
+                 *  Description: Build the Eytzinger layout of the
+                 *               keys, lookups use it until the set is
+                 *               next changed. Worth it for a set that
+                 *               is read far more often than written
+                 *
+                 *  Exception: 1) OutOfMemory() if the layout can't be
+                 *                allocated, lookups keep working
+                 *                without it
+                 */
+
+
+                bool hasIndex() const noexcept;
+
+
+            private:
+                DArray<K> keys;
+                detail::EytzingerIndex<K, Compare> index;
+                Compare less;
+
+                size_t position(const K&) const;
+
+                bool equal(size_t, const K&) const;
+                /*
+                 *  Description: Returns true if the key at the
+                 *               position exists and is equal to the
+                 *               given one
+                 */
+        };
+
+
+
+
+    template <typename K, typename V, typename Compare = std::less<K> >
+        class FlatMap{
+
+            /*  // Summary of available services
+             *
+             *  Map kept as two DArrays, the sorted keys and their
+             *  values at the same positions. Searching reads keys
+             *  only, so as many keys as possible share each cache
+             *  line. Lookups work like FlatSet.
+             *
+             *  value_array is DArray<V> and value_reference and
+             *  value_pointer are V& and V*, except for bool values: as
+             *  DArray<bool> holds bits they are kept in a DArray of
+             *  detail::FlatBool, which converts to and from bool, and
+             *  handed out as FlatBool& and FlatBool*. Reading and
+             *  assigning through them works as with bool& and bool*.
+             *
+             *  FlatMap();
+             *
+             *  explicit FlatMap(Compare);
+             *
+             *  template <typename InputIt>
+             *      FlatMap(InputIt, InputIt, Compare = Compare());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void reserve(size_t);
+             *
+             *  bool insert(const K&, const V&);
+             *
+             *  template <typename InputIt>
+             *      size_t insert(InputIt, InputIt);
+             *
+             *  value_reference operator[](const K&);
+             *
+             *  const_value_reference at(const K&) const;
+             *
+             *  value_reference at(const K&);
+             *
+             *  const_value_pointer find(const K&) const;
+             *
+             *  value_pointer find(const K&);
+             *
+             *  bool contains(const K&) const;
+             *
+             *  bool erase(const K&);
+             *
+             *  const K& keyAt(size_t) const;
+             *
+             *  const_value_reference valueAt(size_t) const;
+             *
+             *  value_reference valueAt(size_t);
+             *
+             *  const DArray<K>& keys() const;
+             *
+             *  const value_array& values() const;
+             *
+             *  void buildIndex();
+             *
+             *  bool hasIndex() const;
+             */
+
+            public:
+                typedef DArray<typename detail::FlatValue<V>::type>
+                    value_array;
+                typedef typename detail::FlatValue<V>::type&
+                    value_reference;
+                typedef const typename detail::FlatValue<V>::type&
+                    const_value_reference;
+                typedef typename detail::FlatValue<V>::type* value_pointer;
+                typedef const typename detail::FlatValue<V>::type*
+                    const_value_pointer;
+
+                FlatMap();
+
+                explicit FlatMap(Compare);
+
+
+                template <typename InputIt>
+                    FlatMap(InputIt, InputIt, Compare = Compare());
+                /*
+                 *  Description: Build the map from unsorted pairs
+                 *               (anything with first and second):
+                 *               the pairs are sorted once by key and
+                 *               repeated keys dropped in one pass,
+                 *               the first pair of a key wins like it
+                 *               would with inserts
+                 *
+                 *  Exception: 1) OutOfMemory() if the pairs can't be
+                 *                stored
+                 *
+                 *  Remark: Best & Worst case: O(n log n)
+                 */
+
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+
+                void reserve(size_t);
+
+
+                bool insert(const K&, const V&);
+                /*
+                 *  Description: Add a key and its value if the map
+                 *               doesn't hold the key, an existing
+                 *               value is not replaced
+                 *
+                 *  Output: 1) true if the pair was added
+                 *
+                 *  Remark: Worst case: O(n)
+                 */
+
+
+                template <typename InputIt>
+                    size_t insert(InputIt, InputIt);
+                /*
+                 *  Description: Add a batch of unsorted pairs, sorted
+                 *               and merged with the map in one pass.
+                 *               Keys the map holds already keep their
+                 *               value
+                 *
+                 *  Output: 1) Number of pairs added
+                 *
+                 *  Exception: 1) OutOfMemory() if the merged map
+                 *                can't be stored, the map is unchanged
+                 *
+                 *  Remark: Best & Worst case: O(n + m log m)
+                 */
+
+
+                value_reference operator[](const K&);
+                /*
+                 *  Description: Returns the value of the key, a
+                 *               default constructed value is added
+                 *               first if the map doesn't hold it
+                 */
+
+
+                const_value_reference at(const K&) const;
+
+                value_reference at(const K&);
+                /*
+                 *  Exception: 1) KeyNotFound() if the map doesn't
+                 *                hold the key
+                 */
+
+
+                const_value_pointer find(const K&) const;
+
+                value_pointer find(const K&);
+                /*
+                 *  Description: Returns the value of the key, or
+                 *               nullptr if the map doesn't hold it
+                 *
+                 *  Remark: Best & Worst case: O(log n)
+                 */
+
+
+                bool contains(const K&) const;
+
+                bool erase(const K&);
+
+
+                const K& keyAt(size_t) const;
+
+                const_value_reference valueAt(size_t) const;
+
+                value_reference valueAt(size_t);
+                /*
+                 *  Description: Key and value at the specified
+                 *               position, keys are in ascending order
+                 *
+                 *  Exception: 1) InvalidIndexException() if the
+                 *                position is not below size()
+                 */
+
+
+                const DArray<K>& keys() const noexcept;
+
+                const value_array& values() const noexcept;
+
+
+                void buildIndex();
+
+                bool hasIndex() const noexcept;
+
+
+            private:
+                DArray<K> keyItems;
+                value_array valueItems;
+                detail::EytzingerIndex<K, Compare> index;
+                Compare less;
+
+                size_t position(const K&) const;
+
+                bool equal(size_t, const K&) const;
+
+                void addAt(size_t, const K&, const V&);
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	               Class FlatSet              ||
+    //					          ||
+    //--------------------------------------------||
+
+    template <typename K, typename C>
+        FlatSet<K,C>::FlatSet(): keys(), index(), less(){}
+
+
+    template <typename K, typename C>
+        FlatSet<K,C>::FlatSet(C compare): keys(), index(), less(compare){}
+
+
+    template <typename K, typename C>
+        template <typename InputIt>
+        FlatSet<K,C>::FlatSet(InputIt first, InputIt last, C compare):
+            keys(), index(), less(compare){
+                keys.append(first, last);
+                std::sort(keys.begin(), keys.end(), less);
+                detail::dropDuplicates(keys,
+                        [](const K& key) -> const K&{ return key; }, less);
+            }
+
+
+    template <typename K, typename C>
+        inline size_t FlatSet<K,C>::size() const noexcept{
+            return keys.size();
+        }
+
+
+    template <typename K, typename C>
+        inline bool FlatSet<K,C>::isEmpty() const noexcept{
+            return keys.isEmpty();
+        }
+
+
+    template <typename K, typename C>
+        void FlatSet<K,C>::clear(){
+            index.clear();
+            keys.clear();
+        }
+
+
+    template <typename K, typename C>
+        void FlatSet<K,C>::reserve(size_t inputSize){
+            keys.reserve(inputSize);
+        }
+
+
+    template <typename K, typename C>
+        bool FlatSet<K,C>::insert(const K& key){
+            size_t place = position(key);
+
+            if (equal(place, key)){
+                return false;
+            }
+
+            keys.add(key, place);
+            index.clear();
+
+            return true;
+        }
+
+
+    template <typename K, typename C>
+        template <typename InputIt>
+        size_t FlatSet<K,C>::insert(InputIt first, InputIt last){
+            DArray<K> batch;
+            batch.append(first, last);
+            std::sort(batch.begin(), batch.end(), less);
+            detail::dropDuplicates(batch,
+                    [](const K& key) -> const K&{ return key; }, less);
+
+            DArray<K> merged;
+            merged.reserve(keys.size() + batch.size());
+
+            size_t i = 0;
+            size_t j = 0;
+
+            // Copies rather than moves, an exception leaves the
+            // set as it was
+            while (i < keys.size() && j < batch.size()){
+                if (less(batch[j], keys[i])){
+                    merged.append(std::move(batch[j++]));
+                }else{
+                    if (!less(keys[i], batch[j])){
+                        ++j;
+                    }
+
+                    merged.append(keys[i++]);
+                }
+            }
+
+            for (; i < keys.size(); ++i){
+                merged.append(keys[i]);
+            }
+
+            for (; j < batch.size(); ++j){
+                merged.append(std::move(batch[j]));
+            }
+
+            size_t added = merged.size() - keys.size();
+
+            index.clear();
+            keys = std::move(merged);
+
+            return added;
+        }
+
+
+    template <typename K, typename C>
+        bool FlatSet<K,C>::erase(const K& key){
+            size_t place = position(key);
+
+            if (!equal(place, key)){
+                return false;
+            }
+
+            index.clear();
+            keys.remove(place);
+
+            return true;
+        }
+
+
+    template <typename K, typename C>
+        inline bool FlatSet<K,C>::contains(const K& key) const{
+            return equal(position(key), key);
+        }
+
+
+    template <typename K, typename C>
+        const K* FlatSet<K,C>::find(const K& key) const{
+            size_t place = position(key);
+            return equal(place, key) ? keys.begin() + place : end();
+        }
+
+
+    template <typename K, typename C>
+        const K* FlatSet<K,C>::lower_bound(const K& key) const{
+            return keys.begin() + position(key);
+        }
+
+
+    template <typename K, typename C>
+        void FlatSet<K,C>::buildIndex(){
+            index.build(keys);
+        }
+
+
+    template <typename K, typename C>
+        inline bool FlatSet<K,C>::hasIndex() const noexcept{
+            return index.isBuilt();
+        }
+
+
+    template <typename K, typename C>
+        inline size_t FlatSet<K,C>::position(const K& key) const{
+            if (index.isBuilt()){
+                return index.lowerBound(key, less);
+            }
+
+            return detail::lowerBound(keys.begin(), keys.size(), key, less);
+        }
+
+
+    template <typename K, typename C>
+        inline bool FlatSet<K,C>::equal(size_t place, const K& key) const{
+            return place < keys.size() && !less(key, keys.begin()[place]);
+        }
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	               Class FlatMap              ||
+    //					          ||
+    //--------------------------------------------||
+
+    template <typename K, typename V, typename C>
+        FlatMap<K,V,C>::FlatMap(): keyItems(), valueItems(), index(),
+        less(){}
+
+
+    template <typename K, typename V, typename C>
+        FlatMap<K,V,C>::FlatMap(C compare): keyItems(), valueItems(),
+        index(), less(compare){}
+
+
+    template <typename K, typename V, typename C>
+        template <typename InputIt>
+        FlatMap<K,V,C>::FlatMap(InputIt first, InputIt last, C compare):
+            keyItems(), valueItems(), index(), less(compare){
+                insert(first, last);
+            }
+
+
+    template <typename K, typename V, typename C>
+        inline size_t FlatMap<K,V,C>::size() const noexcept{
+            return keyItems.size();
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline bool FlatMap<K,V,C>::isEmpty() const noexcept{
+            return keyItems.isEmpty();
+        }
+
+
+    template <typename K, typename V, typename C>
+        void FlatMap<K,V,C>::clear(){
+            index.clear();
+            keyItems.clear();
+            valueItems.clear();
+        }
+
+
+    template <typename K, typename V, typename C>
+        void FlatMap<K,V,C>::reserve(size_t inputSize){
+            keyItems.reserve(inputSize);
+            valueItems.reserve(inputSize);
+        }
+
+
+    template <typename K, typename V, typename C>
+        bool FlatMap<K,V,C>::insert(const K& key, const V& value){
+            size_t place = position(key);
+
+            if (equal(place, key)){
+                return false;
+            }
+
+            addAt(place, key, value);
+            return true;
+        }
+
+
+    template <typename K, typename V, typename C>
+        template <typename InputIt>
+        size_t FlatMap<K,V,C>::insert(InputIt first, InputIt last){
+            DArray< std::pair<K,V> > batch;
+
+            for (; first != last; ++first){
+                batch.append(std::pair<K,V>(first->first, first->second));
+            }
+
+            // Stable, so the first pair of a repeated key is the
+            // one kept
+            std::stable_sort(batch.begin(), batch.end(),
+                    [this](const std::pair<K,V>& a,
+                        const std::pair<K,V>& b){
+                    return less(a.first, b.first);
+                    });
+            detail::dropDuplicates(batch,
+                    [](const std::pair<K,V>& item) -> const K&{
+                    return item.first;
+                    }, less);
+
+            DArray<K> mergedKeys;
+            value_array mergedValues;
+            mergedKeys.reserve(keyItems.size() + batch.size());
+            mergedValues.reserve(keyItems.size() + batch.size());
+
+            size_t i = 0;
+            size_t j = 0;
+
+            while (i < keyItems.size() || j < batch.size()){
+                bool fromBatch = i == keyItems.size() || (j < batch.size()
+                        && less(batch[j].first, keyItems[i]));
+
+                if (fromBatch){
+                    mergedKeys.append(std::move(batch[j].first));
+                    mergedValues.append(std::move(batch[j].second));
+                    ++j;
+                }else{
+                    if (j < batch.size() &&
+                            !less(keyItems[i], batch[j].first)){
+                        ++j;
+                    }
+
+                    mergedKeys.append(keyItems[i]);
+                    mergedValues.append(valueItems[i]);
+                    ++i;
+                }
+            }
+
+            size_t added = mergedKeys.size() - keyItems.size();
+
+            index.clear();
+            keyItems = std::move(mergedKeys);
+            valueItems = std::move(mergedValues);
+
+            return added;
+        }
+
+
+    template <typename K, typename V, typename C>
+        typename FlatMap<K,V,C>::value_reference
+        FlatMap<K,V,C>::operator[](const K& key){
+            size_t place = position(key);
+
+            if (!equal(place, key)){
+                addAt(place, key, V());
+            }
+
+            return valueItems.begin()[place];
+        }
+
+
+    template <typename K, typename V, typename C>
+        typename FlatMap<K,V,C>::const_value_reference
+        FlatMap<K,V,C>::at(const K& key) const{
+            const_value_pointer value = find(key);
+
+            if (value == nullptr){
+                throw KeyNotFound();
+            }
+
+            return *value;
+        }
+
+
+    template <typename K, typename V, typename C>
+        typename FlatMap<K,V,C>::value_reference
+        FlatMap<K,V,C>::at(const K& key){
+            value_pointer value = find(key);
+
+            if (value == nullptr){
+                throw KeyNotFound();
+            }
+
+            return *value;
+        }
+
+
+    template <typename K, typename V, typename C>
+        typename FlatMap<K,V,C>::const_value_pointer
+        FlatMap<K,V,C>::find(const K& key) const{
+            size_t place = position(key);
+            return equal(place, key) ? valueItems.begin() + place : nullptr;
+        }
+
+
+    template <typename K, typename V, typename C>
+        typename FlatMap<K,V,C>::value_pointer
+        FlatMap<K,V,C>::find(const K& key){
+            size_t place = position(key);
+            return equal(place, key) ? valueItems.begin() + place : nullptr;
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline bool FlatMap<K,V,C>::contains(const K& key) const{
+            return equal(position(key), key);
+        }
+
+
+    template <typename K, typename V, typename C>
+        bool FlatMap<K,V,C>::erase(const K& key){
+            size_t place = position(key);
+
+            if (!equal(place, key)){
+                return false;
+            }
+
+            index.clear();
+            keyItems.remove(place);
+            valueItems.remove(place);
+
+            return true;
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline const K& FlatMap<K,V,C>::keyAt(size_t place) const{
+            return keyItems.at(place);
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline typename FlatMap<K,V,C>::const_value_reference
+        FlatMap<K,V,C>::valueAt(size_t place) const{
+            if (place >= valueItems.size()){
+                throw InvalidIndexException();
+            }
+
+            return valueItems.begin()[place];
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline typename FlatMap<K,V,C>::value_reference
+        FlatMap<K,V,C>::valueAt(size_t place){
+            if (place >= valueItems.size()){
+                throw InvalidIndexException();
+            }
+
+            return valueItems.begin()[place];
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline const DArray<K>& FlatMap<K,V,C>::keys() const noexcept{
+            return keyItems;
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline const typename FlatMap<K,V,C>::value_array&
+        FlatMap<K,V,C>::values() const noexcept{
+            return valueItems;
+        }
+
+
+    template <typename K, typename V, typename C>
+        void FlatMap<K,V,C>::buildIndex(){
+            index.build(keyItems);
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline bool FlatMap<K,V,C>::hasIndex() const noexcept{
+            return index.isBuilt();
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline size_t FlatMap<K,V,C>::position(const K& key) const{
+            if (index.isBuilt()){
+                return index.lowerBound(key, less);
+            }
+
+            return detail::lowerBound(keyItems.begin(), keyItems.size(),
+                    key, less);
+        }
+
+
+    template <typename K, typename V, typename C>
+        inline bool FlatMap<K,V,C>::equal(size_t place, const K& key)
+        const{
+            return place < keyItems.size() &&
+                !less(key, keyItems.begin()[place]);
+        }
+
+
+    template <typename K, typename V, typename C>
+        void FlatMap<K,V,C>::addAt(size_t place, const K& key,
+                const V& value){
+            keyItems.add(key, place);
+
+            try{
+                valueItems.add(value, place);
+            }catch (...){
+                keyItems.remove(place);
+                throw;
+            }
+
+            index.clear();
+        }
+
+} // namespace zh
+
+#endif /* ifndef FLATMAP */
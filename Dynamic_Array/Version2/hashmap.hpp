@@ -0,0 +1,953 @@
+/*
+ * Filename:      hashmap.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:30 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef HASHMAP
+#define HASHMAP
+#include "dynarray.hpp"
+#include "simd.hpp"
+#include <cstddef>
+using std::size_t;
+#include <new>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        inline size_t hashBytes(const char* bytes, size_t length) noexcept{
+            // Eight bytes per multiply, HashMap mixes the result
+            // again so this only has to spread the input
+            unsigned long long hash = 0x9E3779B97F4A7C15ULL ^ length;
+
+            for (; length >= 8; bytes += 8, length -= 8){
+                unsigned long long word;
+                std::memcpy(&word, bytes, 8);
+                hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+                hash ^= hash >> 32;
+            }
+
+            unsigned long long tail = 0;
+            std::memcpy(&tail, bytes, length);
+            hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+
+            return static_cast<size_t>(hash ^ (hash >> 29));
+        }
+
+
+        template <typename K, bool TEXT = IsText<K>::value>
+            struct HashOf{
+                size_t operator()(const K& key) const{
+                    return std::hash<K>()(key);
+                }
+            };
+
+        template <typename K>
+            struct HashOf<K, true>{
+                size_t operator()(const K& key) const{
+                    return hashBytes(key.c_str(), key.length());
+                }
+            };
+
+    } // namespace detail
+
+
+    template <typename K>
+        struct Hash: detail::HashOf<K>{};
+    /*
+     *  Description: Default hash of HashMap. Any type with c_str()
+     *               and length() (String, std::string) is hashed
+     *               byte by byte, anything else uses std::hash
+     */
+
+
+    namespace detail{
+
+        // A group of 16 control bytes, one per slot: EMPTY,
+        // DELETED or the low 7 bits of the hash of a full slot. One
+        // SSE2 compare checks all 16 slots for a hash, only slots
+        // whose bits match compare their keys.
+
+        struct ControlGroup{
+            static const size_t WIDTH = 16;
+
+            enum Control: signed char{
+                EMPTY = -128,
+                DELETED = -2
+            };
+
+            explicit ControlGroup(const signed char* bytes) noexcept;
+
+            unsigned match(signed char) const noexcept;
+
+            unsigned matchEmpty() const noexcept;
+
+            unsigned matchFree() const noexcept;
+            /*
+             *  Description: Bit i of the result is set if slot i
+             *               holds the hash bits, is empty, or is
+             *               empty or deleted respectively
+             */
+
+#ifdef ZH_SIMD_SSE2
+            __m128i bytes;
+#else
+            const signed char* bytes;
+
+            unsigned scalarMatch(signed char) const noexcept;
+#endif
+        };
+
+    } // namespace detail
+
+
+    template <typename K, typename V, typename HashFunction = Hash<K>,
+             typename KeyEqual = std::equal_to<K> >
+        class HashMap{
+
+            /*  // Summary of available services
+             *
+             *  Open addressing hash map: the pairs live in one DArray
+             *  of slots, a second DArray holds one control byte per
+             *  slot (SwissTable layout). A lookup hashes once, then
+             *  checks 16 control bytes per step with SSE2 and only
+             *  compares keys whose 7 hash bits match. The table is
+             *  kept at most 7/8 full and doubles when it runs out.
+             *
+             *  HashMap();
+             *
+             *  explicit HashMap(HashFunction, KeyEqual = KeyEqual());
+             *
+             *  ~HashMap() noexcept;
+             *
+             *  HashMap(const HashMap&);
+             *
+             *  HashMap(HashMap&&) noexcept;
+             *
+             *  HashMap& operator=(HashMap);
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  size_t capacity() const;
+             *
+             *  void clear();
+             *
+             *  void reserve(size_t);
+             *
+             *  bool insert(const K&, const V&);
+             *
+             *  V& operator[](const K&);
+             *
+             *  const V& at(const K&) const;
+             *
+             *  V& at(const K&);
+             *
+             *  const V* find(const K&) const;
+             *
+             *  V* find(const K&);
+             *
+             *  bool contains(const K&) const;
+             *
+             *  bool erase(const K&);
+             *
+             *  iterator begin(); iterator end();
+             *
+             *  const_iterator begin() const; const_iterator end() const;
+             */
+
+            public:
+                typedef std::pair<const K, V> Entry;
+
+                template <bool CONST>
+                    class Iterator;
+
+                typedef Iterator<false> iterator;
+                typedef Iterator<true> const_iterator;
+
+                iterator begin(){ return iterator(this, next(0));};
+                iterator end(){ return iterator(this, slotCount);};
+                const_iterator begin() const{
+                    return const_iterator(this, next(0));
+                };
+                const_iterator end() const{
+                    return const_iterator(this, slotCount);
+                };
+
+
+                HashMap();
+
+                explicit HashMap(HashFunction, KeyEqual = KeyEqual());
+                /*
+                 *  Description: Create an empty map, no memory is
+                 *               allocated until the first insert
+                 */
+
+
+                ~HashMap() noexcept;
+
+
+                HashMap(const HashMap&);
+                /*
+                 *  Exception: 1) OutOfMemory() if the copy can't be
+                 *                allocated
+                 */
+
+
+                HashMap(HashMap&&) noexcept;
+
+
+                HashMap& operator=(HashMap);
+
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                size_t capacity() const noexcept;
+                /*
+                 *  Description: Returns the number of slots, a power
+                 *               of two or zero
+                 */
+
+
+                void clear();
+                /*
+                 *  Post-condition: 1) Every pair is destroyed, the
+                 *                     slots are kept for reuse
+                 */
+
+
+                void reserve(size_t);
+                /*
+                 *  Description: Make room for the specified number of
+                 *               pairs without another rehash
+                 *
+                 *  Exception: 1) OutOfMemory() if the slots can't be
+                 *                allocated, the map is unchanged
+                 *
+                 *  Remark: Best & Worst case: O(n), every pair moves
+                 *          to its slot in the new table
+                 */
+
+
+                bool insert(const K&, const V&);
+                /*
+                 *  Description: Add a key and its value if the map
+                 *               doesn't hold the key, an existing
+                 *               value is not replaced
+                 *
+                 *  Output: 1) true if the pair was added
+                 *
+                 *  Exception: 1) OutOfMemory() if the table has to
+                 *                grow and can't
+                 *             2) An exception of a constructor is
+                 *                passed on
+                 *             In both cases the map is unchanged
+                 *
+                 *  Remark: Best case: O(1). Worst case: O(n) when the
+                 *          table grows
+                 */
+
+
+                V& operator[](const K&);
+                /*
+                 *  Description: Returns the value of the key, a
+                 *               default constructed value is added
+                 *               first if the map doesn't hold it
+                 */
+
+
+                const V& at(const K&) const;
+
+                V& at(const K&);
+                /*
+                 *  Exception: 1) KeyNotFound() if the map doesn't
+                 *                hold the key
+                 */
+
+
+                const V* find(const K&) const;
+
+                V* find(const K&);
+                /*
+                 *  Description: Returns the value of the key, or
+                 *               nullptr if the map doesn't hold it
+                 *
+                 *  Remark: Best case: O(1), one group of 16 slots
+                 */
+
+
+                bool contains(const K&) const;
+
+
+                bool erase(const K&);
+                /*
+                 *  Description: Remove the key and its value
+                 *
+                 *  Output: 1) true if the map held the key
+                 *
+                 *  Remark: The slot is marked deleted so lookups
+                 *          probing past it still work, deleted
+                 *          slots are reused by inserts and dropped
+                 *          by the next rehash
+                 */
+
+
+                template <bool CONST>
+                    class Iterator{
+
+                        /*
+                         *  Forward iterator over the pairs in slot
+                         *  order, which is no particular order.
+                         *  Inserts may rehash and invalidate it
+                         */
+
+                        public:
+                            typedef std::forward_iterator_tag
+                                iterator_category;
+                            typedef Entry value_type;
+                            typedef std::ptrdiff_t difference_type;
+                            typedef typename std::conditional<CONST,
+                                    const Entry*, Entry*>::type pointer;
+                            typedef typename std::conditional<CONST,
+                                    const Entry&, Entry&>::type reference;
+                            typedef typename std::conditional<CONST,
+                                    const HashMap*, HashMap*>::type Owner;
+
+                            Iterator() noexcept: map(nullptr), slot(0){}
+
+                            Iterator(Owner owner, size_t index) noexcept:
+                                map(owner), slot(index){}
+
+                            // An iterator converts to a const_iterator
+                            Iterator(const Iterator<false>& other)
+                                noexcept: map(other.map), slot(other.slot){}
+
+                            reference operator*() const{
+                                return *map->entry(slot);
+                            }
+
+                            pointer operator->() const{
+                                return map->entry(slot);
+                            }
+
+                            Iterator& operator++(){
+                                slot = map->next(slot + 1);
+                                return *this;
+                            }
+
+                            Iterator operator++(int){
+                                Iterator old(*this);
+                                ++*this;
+                                return old;
+                            }
+
+                            bool operator==(const Iterator& other) const{
+                                return slot == other.slot;
+                            }
+
+                            bool operator!=(const Iterator& other) const{
+                                return slot != other.slot;
+                            }
+
+                        private:
+                            Owner map;
+                            size_t slot;
+
+                            friend class Iterator<true>;
+                    };
+
+
+            private:
+                typedef typename std::aligned_storage<sizeof(Entry),
+                        alignof(Entry)>::type Slot;
+
+                static const size_t WIDTH = detail::ControlGroup::WIDTH;
+
+                // control has WIDTH bytes more than there are slots,
+                // a copy of the first WIDTH, so a group can be read
+                // at any slot without wrapping around
+                DArray<signed char> control;
+                DArray<Slot> slots;
+                size_t slotCount;
+                size_t count;
+                size_t growthLeft;
+                HashFunction hasher;
+                KeyEqual equal;
+
+
+                size_t hashOf(const K&) const;
+                /*
+                 *  Description: Hash of the key, mixed so that both
+                 *               the low 7 bits and the rest are
+                 *               usable even for a weak hash
+                 */
+
+
+                size_t findSlot(const K&, size_t) const;
+                /*
+                 *  Description: Returns the slot holding the key, or
+                 *               slotCount if the map doesn't hold it
+                 */
+
+
+                size_t freeSlot(size_t) const noexcept;
+                /*
+                 *  Description: Returns the first empty or deleted
+                 *               slot on the probe path of the hash
+                 *
+                 *  Pre-condition: 1) The table has an empty slot
+                 */
+
+
+                size_t add(const K&, size_t, const V&);
+                /*
+                 *  Description: Construct a pair in a free slot for a
+                 *               key the map doesn't hold, growing the
+                 *               table first if needed
+                 *
+                 *  Output: 1) The slot of the new pair
+                 */
+
+
+                void rehash(size_t);
+                /*
+                 *  Description: Move every pair to a new table of the
+                 *               specified number of slots, deleted
+                 *               slots are dropped on the way
+                 *
+                 *  Exception: 1) OutOfMemory() if the table can't be
+                 *                allocated
+                 *             2) An exception of a constructor is
+                 *                passed on
+                 *             In both cases the map is unchanged
+                 */
+
+
+                void setControl(size_t, signed char) noexcept;
+
+                Entry* entry(size_t) const noexcept;
+
+                size_t next(size_t) const noexcept;
+                /*
+                 *  Description: Returns the first full slot at or
+                 *               after the index, or slotCount
+                 */
+
+
+                void destroyAll() noexcept;
+
+
+                static size_t maxLoad(size_t) noexcept;
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	           Struct ControlGroup            ||
+    //					          ||
+    //--------------------------------------------||
+
+    namespace detail{
+
+#ifdef ZH_SIMD_SSE2
+        inline ControlGroup::ControlGroup(const signed char* at) noexcept:
+            bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at))){}
+
+
+        inline unsigned ControlGroup::match(signed char hash) const noexcept{
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(bytes, _mm_set1_epi8(hash))));
+        }
+
+
+        inline unsigned ControlGroup::matchEmpty() const noexcept{
+            return match(EMPTY);
+        }
+
+
+        inline unsigned ControlGroup::matchFree() const noexcept{
+            // EMPTY and DELETED are the only negative bytes
+            return static_cast<unsigned>(_mm_movemask_epi8(bytes));
+        }
+#else
+        inline ControlGroup::ControlGroup(const signed char* at) noexcept:
+            bytes(at){}
+
+
+        inline unsigned ControlGroup::scalarMatch(signed char hash)
+            const noexcept{
+            unsigned result = 0;
+
+            for (size_t i=0; i < WIDTH; ++i){
+                result |= static_cast<unsigned>(bytes[i] == hash) << i;
+            }
+
+            return result;
+        }
+
+
+        inline unsigned ControlGroup::match(signed char hash) const noexcept{
+            return scalarMatch(hash);
+        }
+
+
+        inline unsigned ControlGroup::matchEmpty() const noexcept{
+            return scalarMatch(EMPTY);
+        }
+
+
+        inline unsigned ControlGroup::matchFree() const noexcept{
+            unsigned result = 0;
+
+            for (size_t i=0; i < WIDTH; ++i){
+                result |= static_cast<unsigned>(bytes[i] < 0) << i;
+            }
+
+            return result;
+        }
+#endif
+
+    } // namespace detail
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	               Class HashMap              ||
+    //					          ||
+    //--------------------------------------------||
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>::HashMap(): control(), slots(), slotCount(0),
+        count(0), growthLeft(0), hasher(), equal(){}
+
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>::HashMap(H hash, E keyEqual): control(), slots(),
+        slotCount(0), count(0), growthLeft(0), hasher(hash),
+        equal(keyEqual){}
+
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>::~HashMap() noexcept{
+            destroyAll();
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>::HashMap(const HashMap& copy): control(), slots(),
+        slotCount(0), count(0), growthLeft(0), hasher(copy.hasher),
+        equal(copy.equal){
+            reserve(copy.count);
+
+            for (const_iterator i = copy.begin(); i != copy.end(); ++i){
+                add(i->first, hashOf(i->first), i->second);
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>::HashMap(HashMap&& other) noexcept:
+            control(std::move(other.control)),
+            slots(std::move(other.slots)), slotCount(other.slotCount),
+            count(other.count), growthLeft(other.growthLeft),
+            hasher(other.hasher), equal(other.equal){
+
+                other.slotCount = other.count = other.growthLeft = 0;
+            }
+
+
+    template <typename K, typename V, typename H, typename E>
+        HashMap<K,V,H,E>& HashMap<K,V,H,E>::operator=(HashMap rhs){
+            // rhs is a copy or was moved from, swapping through it
+            // gives the strong guarantee
+            destroyAll();
+            control = std::move(rhs.control);
+            slots = std::move(rhs.slots);
+            slotCount = rhs.slotCount;
+            count = rhs.count;
+            growthLeft = rhs.growthLeft;
+            hasher = rhs.hasher;
+            equal = rhs.equal;
+
+            rhs.slotCount = rhs.count = rhs.growthLeft = 0;
+            return *this;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline size_t HashMap<K,V,H,E>::size() const noexcept{
+            return count;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline bool HashMap<K,V,H,E>::isEmpty() const noexcept{
+            return count == 0;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline size_t HashMap<K,V,H,E>::capacity() const noexcept{
+            return slotCount;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        void HashMap<K,V,H,E>::clear(){
+            destroyAll();
+
+            for (size_t i=0; i < control.size(); ++i){
+                control[i] = detail::ControlGroup::EMPTY;
+            }
+
+            count = 0;
+            growthLeft = maxLoad(slotCount);
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        void HashMap<K,V,H,E>::reserve(size_t inputSize){
+            if (inputSize == 0){
+                return;
+            }
+
+            size_t target = (slotCount == 0) ? WIDTH : slotCount;
+
+            while (maxLoad(target) < inputSize){
+                target *= 2;
+            }
+
+            if (target > slotCount){
+                rehash(target);
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        bool HashMap<K,V,H,E>::insert(const K& key, const V& value){
+            size_t hash = hashOf(key);
+
+            if (findSlot(key, hash) != slotCount){
+                return false;
+            }
+
+            add(key, hash, value);
+            return true;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        V& HashMap<K,V,H,E>::operator[](const K& key){
+            size_t hash = hashOf(key);
+            size_t slot = findSlot(key, hash);
+
+            if (slot == slotCount){
+                slot = add(key, hash, V());
+            }
+
+            return entry(slot)->second;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        const V& HashMap<K,V,H,E>::at(const K& key) const{
+            const V* value = find(key);
+
+            if (value == nullptr){
+                throw KeyNotFound();
+            }
+
+            return *value;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        V& HashMap<K,V,H,E>::at(const K& key){
+            V* value = find(key);
+
+            if (value == nullptr){
+                throw KeyNotFound();
+            }
+
+            return *value;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        const V* HashMap<K,V,H,E>::find(const K& key) const{
+            size_t slot = findSlot(key, hashOf(key));
+            return (slot == slotCount) ? nullptr : &entry(slot)->second;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        V* HashMap<K,V,H,E>::find(const K& key){
+            size_t slot = findSlot(key, hashOf(key));
+            return (slot == slotCount) ? nullptr : &entry(slot)->second;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline bool HashMap<K,V,H,E>::contains(const K& key) const{
+            return findSlot(key, hashOf(key)) != slotCount;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        bool HashMap<K,V,H,E>::erase(const K& key){
+            size_t slot = findSlot(key, hashOf(key));
+
+            if (slot == slotCount){
+                return false;
+            }
+
+            entry(slot)->~Entry();
+            setControl(slot, detail::ControlGroup::DELETED);
+            --count;
+
+            return true;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline size_t HashMap<K,V,H,E>::hashOf(const K& key) const{
+            unsigned long long hash = static_cast<unsigned long long>(
+                    hasher(key)) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        size_t HashMap<K,V,H,E>::findSlot(const K& key, size_t hash) const{
+            if (slotCount == 0){
+                return 0;
+            }
+
+            const signed char* bytes = control.begin();
+            signed char low = static_cast<signed char>(hash & 0x7F);
+            size_t mask = slotCount - 1;
+            size_t position = (hash >> 7) & mask;
+
+            // Steps of 1, 2, 3... groups visit every group of a
+            // power of two table, an empty slot ends the search
+            for (size_t step = WIDTH; ; step += WIDTH){
+                detail::ControlGroup group(bytes + position);
+
+                for (unsigned bits = group.match(low); bits != 0;
+                        bits &= bits - 1){
+                    size_t slot = (position + __builtin_ctz(bits)) & mask;
+
+                    if (equal(entry(slot)->first, key)){
+                        return slot;
+                    }
+                }
+
+                if (group.matchEmpty() != 0){
+                    return slotCount;
+                }
+
+                position = (position + step) & mask;
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        size_t HashMap<K,V,H,E>::freeSlot(size_t hash) const noexcept{
+            const signed char* bytes = control.begin();
+            size_t mask = slotCount - 1;
+            size_t position = (hash >> 7) & mask;
+
+            for (size_t step = WIDTH; ; step += WIDTH){
+                unsigned bits = detail::ControlGroup(bytes + position)
+                    .matchFree();
+
+                if (bits != 0){
+                    return (position + __builtin_ctz(bits)) & mask;
+                }
+
+                position = (position + step) & mask;
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        size_t HashMap<K,V,H,E>::add(const K& key, size_t hash,
+                const V& value){
+            size_t slot = (slotCount == 0) ? 0 : freeSlot(hash);
+
+            // The control byte is only set once the pair exists
+            if (slotCount == 0 || (growthLeft == 0 &&
+                        control[slot] == detail::ControlGroup::EMPTY)){
+                // key or value may be one of our own entries, the
+                // pair is built before rehash() moves them
+                Entry item(key, value);
+
+                // Out of empty slots: double, or only drop the
+                // deleted slots if at most half the load is real
+                rehash((slotCount == 0) ? WIDTH :
+                        (count * 2 > maxLoad(slotCount)) ? slotCount * 2 :
+                        slotCount);
+                slot = freeSlot(hash);
+                new (entry(slot)) Entry(std::move(item));
+            }else{
+                new (entry(slot)) Entry(key, value);
+            }
+
+            if (control[slot] == detail::ControlGroup::EMPTY){
+                --growthLeft;
+            }
+
+            setControl(slot, static_cast<signed char>(hash & 0x7F));
+            ++count;
+
+            return slot;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        void HashMap<K,V,H,E>::rehash(size_t newCount){
+            DArray<signed char> newControl(newCount + WIDTH,
+                    detail::ControlGroup::EMPTY);
+            DArray<Slot> newSlots(newCount);
+            Entry* target = reinterpret_cast<Entry*>(newSlots.begin());
+            size_t mask = newCount - 1;
+            size_t moved = 0;
+            size_t i = 0;
+
+            try{
+                for (i = next(0); i < slotCount; i = next(i + 1)){
+                    size_t hash = hashOf(entry(i)->first);
+                    size_t position = (hash >> 7) & mask;
+                    unsigned bits;
+
+                    for (size_t step = WIDTH; (bits = detail::ControlGroup(
+                                    newControl.begin() + position)
+                                .matchFree()) == 0; step += WIDTH){
+                        position = (position + step) & mask;
+                    }
+
+                    size_t slot = (position + __builtin_ctz(bits)) & mask;
+                    new (target + slot) Entry(
+                            std::move_if_noexcept(*entry(i)));
+
+                    signed char low = static_cast<signed char>(hash & 0x7F);
+                    newControl[slot] = low;
+
+                    if (slot < WIDTH){
+                        newControl[newCount + slot] = low;
+                    }
+
+                    ++moved;
+                }
+            }catch (...){
+                for (size_t j=0; j < newCount && moved > 0; ++j){
+                    if (newControl[j] >= 0){
+                        (target + j)->~Entry();
+                        --moved;
+                    }
+                }
+
+                throw;
+            }
+
+            destroyAll();
+            control = std::move(newControl);
+            slots = std::move(newSlots);
+            slotCount = newCount;
+            growthLeft = maxLoad(newCount) - count;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline void HashMap<K,V,H,E>::setControl(size_t slot,
+                signed char value) noexcept{
+            signed char* bytes = control.begin();
+            bytes[slot] = value;
+
+            if (slot < WIDTH){
+                bytes[slotCount + slot] = value;
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline typename HashMap<K,V,H,E>::Entry*
+        HashMap<K,V,H,E>::entry(size_t slot) const noexcept{
+            return reinterpret_cast<Entry*>(
+                    const_cast<Slot*>(slots.begin()) + slot);
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        size_t HashMap<K,V,H,E>::next(size_t slot) const noexcept{
+            const signed char* bytes = control.begin();
+
+            while (slot < slotCount && bytes[slot] < 0){
+                ++slot;
+            }
+
+            return slot;
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        void HashMap<K,V,H,E>::destroyAll() noexcept{
+            for (size_t i = next(0); i < slotCount; i = next(i + 1)){
+                entry(i)->~Entry();
+            }
+        }
+
+
+    template <typename K, typename V, typename H, typename E>
+        inline size_t HashMap<K,V,H,E>::maxLoad(size_t slots) noexcept{
+            return slots - slots / 8;
+        }
+
+} // namespace zh
+
+#endif /* ifndef HASHMAP */
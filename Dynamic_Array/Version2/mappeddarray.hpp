@@ -0,0 +1,649 @@
+/*
+ * Filename:      mappeddarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (09:00 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef MAPPEDDARRAY
+#define MAPPEDDARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    class MappingFailed{};
+
+    template <typename T, typename GrowthPolicy = DefaultGrowth>
+        class MappedDArray{
+
+            /*  // Summary of available services
+             *
+             *  A dynamic array of trivially copyable objects kept in
+             *  a file through mmap(). The file starts with a small
+             *  header (magic, object size, size) followed by the
+             *  objects, so opening an existing file maps the objects
+             *  back in without reading or converting anything.
+             *  Growing extends the file with ftruncate() and the
+             *  mapping with mremap() (munmap() and mmap() where
+             *  mremap() is not available).
+             *
+             *  MappedDArray(const char*, bool = false);
+             *
+             *  ~MappedDArray() noexcept;
+             *
+             *  MappedDArray(MappedDArray&&) noexcept;
+             *
+             *  MappedDArray& operator=(MappedDArray&&) noexcept;
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  T& operator[](size_t);
+             *
+             *  const T& at(size_t) const;
+             *
+             *  T& at(size_t);
+             *
+             *  void resize(size_t, const T& = T());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void append(const T&);
+             *
+             *  template <typename InputIt>
+             *      void append(InputIt, InputIt);
+             *
+             *  void remove_last();
+             *
+             *  size_t capacity() const;
+             *
+             *  void reserve(size_t);
+             *
+             *  bool isReadOnly() const;
+             *
+             *  void flush();
+             */
+
+            static_assert(std::is_trivially_copyable<T>::value,
+                    "MappedDArray can only hold trivially copyable types");
+
+            public:
+                typedef T* iterator;
+                typedef const T* const_iterator;
+
+                iterator begin(){ return buffer;};
+                iterator end(){ return buffer + size();};
+                const_iterator begin() const{ return buffer;};
+                const_iterator end() const{ return buffer + size();};
+
+                explicit MappedDArray(const char*, bool = false);
+                /*
+                 *  Description: Open the array stored in the
+                 *               specified file, creating an empty
+                 *               one if the file does not exist
+                 *
+                 *  Input: 1) Path of the file
+                 *         2) True to map an existing file read only,
+                 *            no changes are allowed in that mode
+                 *
+                 *  Output: None
+                 *
+                 *  Pre-condition:  1) The file is not used by another
+                 *                     MappedDArray that changes it
+                 *
+                 *  Post-condition: 1) The objects in the file are
+                 *                     accessible without being copied
+                 *
+                 *  Exception: 1) MappingFailed() if the file cannot
+                 *                be opened, created or mapped
+                 *             2) FormatMismatch() if the file was not
+                 *                written by a MappedDArray of an
+                 *                object of the same size
+                 *
+                 *  Remark: Best & Worst case: O(1), pages are only
+                 *          read when they are accessed
+                 */
+
+
+                ~MappedDArray() noexcept;
+                /*
+                 *  Description: Unmap the file and close it, the
+                 *               kernel writes the dirty pages back
+                 */
+
+
+                MappedDArray(MappedDArray&&) noexcept;
+
+                MappedDArray& operator=(MappedDArray&&) noexcept;
+
+                const T& operator[](size_t) const;
+
+                T& operator[](size_t);
+                /*
+                 *  Pre-condition: 1) Objects of a read only mapping
+                 *                    are not written through the
+                 *                    non-const operator[], the pages
+                 *                    can't be written and the process
+                 *                    gets a SIGSEGV
+                 *
+                 *  Exception: None, checked only when
+                 *             ZH_CHECKED_ACCESS is 1 (see dynarray.hpp)
+                 */
+
+
+                const T& at(size_t) const;
+
+                T& at(size_t);
+                /*
+                 *  Exception: 1) Throws InvalidIndexException() if the
+                 *                input index is equal to or greater
+                 *                than the size of the array
+                 *             2) The non-const at() throws
+                 *                MappingFailed() on a read only
+                 *                mapping, use the const one to read
+                 */
+
+
+                void resize(size_t, const T& = T());
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+
+                void append(const T&);
+                /*
+                 *  Description: Copy the object after the last one,
+                 *               growing the file if needed
+                 *
+                 *  Exception: 1) MappingFailed() if the file cannot
+                 *                grow or is read only
+                 *
+                 *  Remark: Worst case: O(1) amortized, the kernel
+                 *          moves the pages of the mapping instead of
+                 *          us copying the objects.
+                 *          Best case: O(1)
+                 */
+
+
+                template <typename InputIt,
+                         typename = typename std::enable_if<
+                             !std::is_integral<InputIt>::value>::type>
+                    void append(InputIt, InputIt);
+
+                void remove_last();
+                /*
+                 *  Exception: 1) ArrayEmpty() exception is thrown
+                 *                is size of array is zero
+                 */
+
+
+                size_t capacity() const noexcept;
+
+                void reserve(size_t);
+                /*
+                 *  Description: Extend the file and the mapping so
+                 *               at least the specified number of
+                 *               objects fit
+                 *
+                 *  Exception: 1) MappingFailed() if the file cannot
+                 *                grow or is read only
+                 */
+
+
+                bool isReadOnly() const noexcept;
+
+                void flush();
+                /*
+                 *  Description: Write the dirty pages back to the
+                 *               file now (msync) instead of whenever
+                 *               the kernel decides to
+                 *
+                 *  Exception: 1) MappingFailed() if msync fails
+                 */
+
+
+            private:
+                struct Header{
+                    char magic[8];
+                    std::uint64_t unitSize;
+                    std::uint64_t count;
+                    std::uint64_t reserved[5];
+                };
+
+                // Objects start right after the header, which also
+                // keeps them aligned on a cache line
+                static const size_t DATA_OFFSET = 64;
+                static_assert(sizeof(Header) <= DATA_OFFSET,
+                        "MappedDArray header does not fit");
+                static_assert(alignof(T) <= DATA_OFFSET,
+                        "MappedDArray cannot align this type");
+
+                int fd;
+                bool readOnly;
+                unsigned char* mapping;
+                size_t mappedBytes;
+                Header* header;
+                T* buffer;
+                size_t physicalSize;
+
+                void mapFile(size_t);
+
+                void growFile(size_t);
+
+                void unmapFile() noexcept;
+
+                void checkWritable() const;
+
+                static size_t fileBytes(size_t) noexcept;
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, typename G>
+        MappedDArray<T,G>::MappedDArray(const char* path, bool mode):
+            fd(-1), readOnly(mode), mapping(nullptr), mappedBytes(0),
+            header(nullptr), buffer(nullptr), physicalSize(0){
+
+                fd = (readOnly) ? ::open(path, O_RDONLY) :
+                    ::open(path, O_RDWR | O_CREAT, 0644);
+
+                if (fd < 0){
+                    throw MappingFailed();
+                }
+
+                struct stat info;
+
+                if (::fstat(fd, &info) != 0){
+                    ::close(fd);
+                    throw MappingFailed();
+                }
+
+                size_t bytes = static_cast<size_t>(info.st_size);
+
+                if (bytes == 0){
+                    if (readOnly){
+                        ::close(fd);
+                        throw FormatMismatch();
+                    }
+
+                    // New file, write an empty header
+                    bytes = fileBytes(G::initial(0));
+
+                    if (::ftruncate(fd, bytes) != 0){
+                        ::close(fd);
+                        throw MappingFailed();
+                    }
+
+                    try{
+                        mapFile(bytes);
+                    }catch (...){
+                        ::close(fd);
+                        throw;
+                    }
+
+                    std::memcpy(header->magic, "ZHDARRAY", 8);
+                    header->unitSize = sizeof(T);
+                    header->count = 0;
+                }else{
+                    if (bytes < DATA_OFFSET){
+                        ::close(fd);
+                        throw FormatMismatch();
+                    }
+
+                    try{
+                        mapFile(bytes);
+                    }catch (...){
+                        ::close(fd);
+                        throw;
+                    }
+
+                    if (std::memcmp(header->magic, "ZHDARRAY", 8) != 0 ||
+                            header->unitSize != sizeof(T) ||
+                            header->count > physicalSize){
+                        unmapFile();
+                        ::close(fd);
+                        throw FormatMismatch();
+                    }
+                }
+            }
+
+
+    template <typename T, typename G>
+        MappedDArray<T,G>::~MappedDArray() noexcept{
+            unmapFile();
+
+            if (fd >= 0){
+                ::close(fd);
+            }
+        }
+
+
+    template <typename T, typename G>
+        MappedDArray<T,G>::MappedDArray(MappedDArray&& other) noexcept:
+            fd(other.fd), readOnly(other.readOnly), mapping(other.mapping),
+            mappedBytes(other.mappedBytes), header(other.header),
+            buffer(other.buffer), physicalSize(other.physicalSize){
+                other.fd = -1;
+                other.mapping = nullptr;
+                other.mappedBytes = 0;
+                other.header = nullptr;
+                other.buffer = nullptr;
+                other.physicalSize = 0;
+            }
+
+
+    template <typename T, typename G>
+        MappedDArray<T,G>& MappedDArray<T,G>::operator=(
+                MappedDArray&& rhs) noexcept{
+            if (this != &rhs){
+                unmapFile();
+
+                if (fd >= 0){
+                    ::close(fd);
+                }
+
+                fd = rhs.fd;
+                readOnly = rhs.readOnly;
+                mapping = rhs.mapping;
+                mappedBytes = rhs.mappedBytes;
+                header = rhs.header;
+                buffer = rhs.buffer;
+                physicalSize = rhs.physicalSize;
+
+                rhs.fd = -1;
+                rhs.mapping = nullptr;
+                rhs.mappedBytes = 0;
+                rhs.header = nullptr;
+                rhs.buffer = nullptr;
+                rhs.physicalSize = 0;
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, typename G>
+        inline const T& MappedDArray<T,G>::operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+            if (index >= size()){
+                detail::indexFailure(index, size(),
+                        "MappedDArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, typename G>
+        inline T& MappedDArray<T,G>::operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+            if (index >= size()){
+                detail::indexFailure(index, size(),
+                        "MappedDArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, typename G>
+        const T& MappedDArray<T,G>::at(size_t index) const{
+            if (index < size()){
+                return *(buffer+index);
+            }else{
+                throw InvalidIndexException();
+            }
+        }
+
+
+    template <typename T, typename G>
+        T& MappedDArray<T,G>::at(size_t index){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            checkWritable();
+            return *(buffer+index);
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::resize(size_t inputSize, const T& value){
+            checkWritable();
+
+            if (inputSize > physicalSize){
+                T item(value);
+                reserve(G::grow(physicalSize, inputSize));
+
+                for (size_t i=size(); i < inputSize; ++i){
+                    *(buffer+i) = item;
+                }
+            }else{
+                for (size_t i=size(); i < inputSize; ++i){
+                    *(buffer+i) = value;
+                }
+            }
+
+            header->count = inputSize;
+        }
+
+
+    template <typename T, typename G>
+        inline size_t MappedDArray<T,G>::size() const noexcept{
+            return (header == nullptr) ? 0 :
+                static_cast<size_t>(header->count);
+        }
+
+
+    template <typename T, typename G>
+        inline bool MappedDArray<T,G>::isEmpty() const noexcept{
+            return size() == 0;
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::clear(){
+            checkWritable();
+            header->count = 0;
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::append(const T& value){
+            checkWritable();
+
+            size_t count = size();
+
+            if (count == physicalSize){
+                T item(value);
+                reserve(G::grow(physicalSize, count + 1));
+                *(buffer+count) = item;
+            }else{
+                *(buffer+count) = value;
+            }
+
+            header->count = count + 1;
+        }
+
+
+    template <typename T, typename G>
+        template <typename InputIt, typename>
+        void MappedDArray<T,G>::append(InputIt first, InputIt last){
+            for (; first != last; ++first){
+                append(*first);
+            }
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::remove_last(){
+            checkWritable();
+
+            if (isEmpty()){
+                throw ArrayEmpty();
+            }else{
+                --header->count;
+            }
+        }
+
+
+    template <typename T, typename G>
+        inline size_t MappedDArray<T,G>::capacity() const noexcept{
+            return physicalSize;
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::reserve(size_t inputSize){
+            if (inputSize > physicalSize){
+                checkWritable();
+                growFile(fileBytes(inputSize));
+            }
+        }
+
+
+    template <typename T, typename G>
+        inline bool MappedDArray<T,G>::isReadOnly() const noexcept{
+            return readOnly;
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::flush(){
+            if (mapping != nullptr && !readOnly &&
+                    ::msync(mapping, mappedBytes, MS_SYNC) != 0){
+                throw MappingFailed();
+            }
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::mapFile(size_t bytes){
+            int protection = (readOnly) ? PROT_READ :
+                (PROT_READ | PROT_WRITE);
+            void* address = ::mmap(nullptr, bytes, protection, MAP_SHARED,
+                    fd, 0);
+
+            if (address == MAP_FAILED){
+                throw MappingFailed();
+            }
+
+            mapping = static_cast<unsigned char*>(address);
+            mappedBytes = bytes;
+            header = reinterpret_cast<Header*>(mapping);
+            buffer = reinterpret_cast<T*>(mapping + DATA_OFFSET);
+            physicalSize = (bytes - DATA_OFFSET) / sizeof(T);
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::growFile(size_t bytes){
+            if (::ftruncate(fd, bytes) != 0){
+                throw MappingFailed();
+            }
+
+#ifdef MREMAP_MAYMOVE
+            void* address = ::mremap(mapping, mappedBytes, bytes,
+                    MREMAP_MAYMOVE);
+
+            if (address == MAP_FAILED){
+                throw MappingFailed();
+            }
+
+            mapping = static_cast<unsigned char*>(address);
+            mappedBytes = bytes;
+            header = reinterpret_cast<Header*>(mapping);
+            buffer = reinterpret_cast<T*>(mapping + DATA_OFFSET);
+            physicalSize = (bytes - DATA_OFFSET) / sizeof(T);
+#else
+            // The objects live in the file, so nothing is lost
+            // when the old mapping goes away
+            unmapFile();
+            mapFile(bytes);
+#endif
+        }
+
+
+    template <typename T, typename G>
+        void MappedDArray<T,G>::unmapFile() noexcept{
+            if (mapping != nullptr){
+                ::munmap(mapping, mappedBytes);
+                mapping = nullptr;
+                mappedBytes = 0;
+                header = nullptr;
+                buffer = nullptr;
+                physicalSize = 0;
+            }
+        }
+
+
+    template <typename T, typename G>
+        inline void MappedDArray<T,G>::checkWritable() const{
+            if (readOnly || mapping == nullptr){
+                throw MappingFailed();
+            }
+        }
+
+
+    template <typename T, typename G>
+        inline size_t MappedDArray<T,G>::fileBytes(size_t count) noexcept{
+            // Whole pages only, the tail of the last page would be
+            // mapped anyway
+            const size_t page = 4096;
+            size_t bytes = DATA_OFFSET + count * sizeof(T);
+
+            return (bytes + page - 1) / page * page;
+        }
+
+} // namespace zh
+
+#endif /* ifndef MAPPEDDARRAY */
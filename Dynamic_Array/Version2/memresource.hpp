@@ -0,0 +1,695 @@
+/*
+ * Filename:      memresource.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (02:05 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef MEMRESOURCE
+#define MEMRESOURCE
+#include <cstddef>
+using std::size_t;
+#include <new>
+using std::bad_alloc;
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define ZH_HAVE_MMAN 1
+#endif
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    class MemoryResource{
+
+        /*  // Summary of available services
+         *
+         *  virtual void* allocate(size_t, size_t) = 0;
+         *
+         *  virtual void deallocate(void*, size_t, size_t) noexcept = 0;
+         *
+         *  MemoryResource* newDeleteResource() noexcept;
+         */
+
+        public:
+            virtual ~MemoryResource(){}
+
+            virtual void* allocate(size_t bytes, size_t alignment) = 0;
+            /*
+             *  Description: Return a block of at least the specified
+             *               number of bytes whose address is a
+             *               multiple of the specified alignment
+             *
+             *  Input: 1) Number of bytes requested
+             *         2) Alignment, a power of two
+             *
+             *  Output: Address of the block
+             *
+             *  Exception: 1) bad_alloc() is thrown when no memory
+             *                is available
+             */
+
+
+            virtual void deallocate(void* block, size_t bytes,
+                    size_t alignment) noexcept = 0;
+            /*
+             *  Description: Give back a block returned by allocate()
+             *               of this resource, bytes and alignment are
+             *               the same values allocate() was called with
+             *
+             *  Exception: None
+             */
+
+
+        protected:
+            MemoryResource(){}
+
+        private:
+            MemoryResource(const MemoryResource&);
+            MemoryResource& operator=(const MemoryResource&);
+    };
+
+
+    inline MemoryResource* newDeleteResource() noexcept;
+    /*
+     *  Description: Resource used by all containers unless told
+     *               otherwise, it forwards to the global operator
+     *               new and delete
+     */
+
+
+    class ArenaResource: public MemoryResource{
+
+        /*
+         *  Monotonic arena: allocate() bumps a pointer through
+         *  blocks obtained from the upstream resource and
+         *  deallocate() does nothing. All the memory is given back
+         *  at once by reset() or by the destructor, so thousands of
+         *  short lived arrays cost one release instead of one
+         *  delete per array.
+         *
+         *  Objects living in the arena still have to be destroyed
+         *  before reset() is called, reset() does not run any
+         *  destructor. Not thread safe.
+         */
+
+        public:
+            explicit ArenaResource(size_t blockSize = 64 * 1024,
+                    MemoryResource* upstream = newDeleteResource());
+
+            ~ArenaResource();
+
+            void* allocate(size_t, size_t);
+
+            void deallocate(void*, size_t, size_t) noexcept{}
+
+            void reset() noexcept;
+            /*
+             *  Description: Make all the memory of the arena available
+             *               again. The most recent block is kept for
+             *               reuse and all the other blocks are given
+             *               back to the upstream resource
+             */
+
+
+            void release() noexcept;
+            /*
+             *  Description: Give every block back to the upstream
+             *               resource
+             */
+
+
+            size_t bytesInUse() const noexcept;
+            /*
+             *  Description: Number of bytes handed out since the
+             *               last reset() or release()
+             */
+
+
+        private:
+            struct Block{
+                Block* next;
+                size_t size;
+            };
+
+            Block* head;
+            unsigned char* current;
+            unsigned char* last;
+            size_t blockSize;
+            size_t used;
+            MemoryResource* upstream;
+
+            void newBlock(size_t);
+    };
+
+
+    class PoolResource: public MemoryResource{
+
+        /*
+         *  Size class pool: requests up to MAX_BLOCK bytes are
+         *  rounded up to a power of two (starting at MIN_BLOCK)
+         *  and served from a free list of blocks of that size.
+         *  deallocate() puts the block back on its free list, so
+         *  arrays that are created and destroyed over and over
+         *  reuse the same memory without calling the upstream
+         *  resource. Larger requests go straight upstream.
+         *
+         *  Not thread safe.
+         */
+
+        public:
+            explicit PoolResource(
+                    MemoryResource* upstream = newDeleteResource());
+
+            ~PoolResource();
+
+            void* allocate(size_t, size_t);
+
+            void deallocate(void*, size_t, size_t) noexcept;
+
+            void release() noexcept;
+            /*
+             *  Description: Give every chunk back to the upstream
+             *               resource, all blocks handed out so far
+             *               become invalid
+             */
+
+
+            static const size_t MIN_BLOCK = 16;
+            static const size_t MAX_BLOCK = 4096;
+
+        private:
+            static const size_t CLASSES = 9; // 16, 32, ..., 4096
+
+            struct Chunk{
+                Chunk* next;
+                size_t size;
+            };
+
+            struct FreeBlock{
+                FreeBlock* next;
+            };
+
+            FreeBlock* freeList[CLASSES];
+            Chunk* chunks;
+            MemoryResource* upstream;
+
+            static size_t sizeClass(size_t) noexcept;
+            void refill(size_t);
+    };
+
+
+
+
+    class AlignedResource: public MemoryResource{
+
+        /*
+         *  Forwards to the upstream resource with every block
+         *  aligned to (and its size rounded up to) at least the
+         *  given alignment: 32 for aligned AVX loads, 64 so that no
+         *  two arrays share a cache line (false sharing).
+         *
+         *      DArray<float> data(*alignedResource<64>());
+         *
+         *  A copy of an array made with the copy constructor uses
+         *  the default resource again.
+         */
+
+        public:
+            explicit AlignedResource(size_t alignment = 64,
+                    MemoryResource* upstream = newDeleteResource())
+                noexcept;
+
+            void* allocate(size_t, size_t);
+
+            void deallocate(void*, size_t, size_t) noexcept;
+
+            size_t alignment() const noexcept;
+
+        private:
+            size_t minimum;
+            MemoryResource* upstream;
+    };
+
+
+    template <size_t ALIGN>
+        MemoryResource* alignedResource() noexcept;
+    /*
+     *  Description: Returns a shared AlignedResource of the given
+     *               alignment over newDeleteResource(), it can be
+     *               used from any thread
+     */
+
+
+    class HugePageResource: public MemoryResource{
+
+        /*
+         *  Blocks of at least threshold bytes are mapped directly
+         *  (mmap), aligned to 2 MiB and marked with
+         *  madvise(MADV_HUGEPAGE) so the kernel backs them with
+         *  huge pages: a multi-GB array then needs 512 times fewer
+         *  TLB entries. Smaller blocks go to the upstream resource.
+         *
+         *  The memory of a mapped block is only committed when it
+         *  is first written. Where mmap() or MADV_HUGEPAGE does not
+         *  exist, blocks are plain mappings or upstream blocks.
+         *  Thread safe if the upstream resource is.
+         */
+
+        public:
+            static const size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+            explicit HugePageResource(size_t threshold = HUGE_PAGE,
+                    MemoryResource* upstream = newDeleteResource())
+                noexcept;
+
+            void* allocate(size_t, size_t);
+
+            void deallocate(void*, size_t, size_t) noexcept;
+
+        private:
+            size_t threshold;
+            MemoryResource* upstream;
+
+            bool mapped(size_t bytes) const noexcept;
+    };
+
+
+    inline MemoryResource* hugePageResource() noexcept;
+    /*
+     *  Description: Returns a shared HugePageResource with the
+     *               default threshold over newDeleteResource()
+     */
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        inline size_t alignUp(size_t value, size_t alignment) noexcept{
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+
+        // Header placed in front of every block, rounded up so
+        // the memory after it keeps the default alignment
+        template <typename H>
+            struct HeaderSize{
+                static const size_t value =
+                    (sizeof(H) + alignof(std::max_align_t) - 1) /
+                    alignof(std::max_align_t) * alignof(std::max_align_t);
+            };
+
+
+        class NewDeleteResource: public MemoryResource{
+            public:
+                void* allocate(size_t bytes, size_t alignment){
+                    if (alignment <= alignof(std::max_align_t)){
+                        return ::operator new(bytes);
+                    }
+
+                    // Over-allocate and remember the address that
+                    // has to be given back right in front of the
+                    // aligned block
+                    unsigned char* raw = static_cast<unsigned char*>(
+                            ::operator new(bytes + alignment + sizeof(void*)));
+                    std::uintptr_t start =
+                        reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+                    unsigned char* block = reinterpret_cast<unsigned char*>(
+                            alignUp(start, alignment));
+                    reinterpret_cast<void**>(block)[-1] = raw;
+
+                    return block;
+                }
+
+                void deallocate(void* block, size_t,
+                        size_t alignment) noexcept{
+                    if (block == nullptr){
+                        return;
+                    }
+
+                    if (alignment <= alignof(std::max_align_t)){
+                        ::operator delete(block);
+                    }else{
+                        ::operator delete(
+                                reinterpret_cast<void**>(block)[-1]);
+                    }
+                }
+        };
+
+    } // namespace detail
+
+
+    inline MemoryResource* newDeleteResource() noexcept{
+        static detail::NewDeleteResource resource;
+        return &resource;
+    }
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	           Class ArenaResource            ||
+    //					          ||
+    //--------------------------------------------||
+
+    inline ArenaResource::ArenaResource(size_t size,
+            MemoryResource* source): head(nullptr), current(nullptr),
+    last(nullptr), blockSize(size), used(0), upstream(source){}
+
+
+    inline ArenaResource::~ArenaResource(){
+        release();
+    }
+
+
+    inline void* ArenaResource::allocate(size_t bytes, size_t alignment){
+        std::uintptr_t start = detail::alignUp(
+                reinterpret_cast<std::uintptr_t>(current), alignment);
+
+        if (current == nullptr ||
+                start + bytes > reinterpret_cast<std::uintptr_t>(last)){
+            newBlock(bytes + alignment);
+            start = detail::alignUp(
+                    reinterpret_cast<std::uintptr_t>(current), alignment);
+        }
+
+        current = reinterpret_cast<unsigned char*>(start + bytes);
+        used += bytes;
+
+        return reinterpret_cast<void*>(start);
+    }
+
+
+    inline void ArenaResource::newBlock(size_t bytes){
+        const size_t header = detail::HeaderSize<Block>::value;
+        size_t size = (bytes + header > blockSize) ?
+            bytes + header : blockSize;
+
+        Block* block = static_cast<Block*>(
+                upstream->allocate(size, alignof(std::max_align_t)));
+        block->next = head;
+        block->size = size;
+        head = block;
+
+        current = reinterpret_cast<unsigned char*>(block) + header;
+        last = reinterpret_cast<unsigned char*>(block) + size;
+    }
+
+
+    inline void ArenaResource::reset() noexcept{
+        if (head == nullptr){
+            return;
+        }
+
+        while (head->next != nullptr){
+            Block* next = head->next;
+            head->next = next->next;
+            upstream->deallocate(next, next->size,
+                    alignof(std::max_align_t));
+        }
+
+        current = reinterpret_cast<unsigned char*>(head) +
+            detail::HeaderSize<Block>::value;
+        used = 0;
+    }
+
+
+    inline void ArenaResource::release() noexcept{
+        while (head != nullptr){
+            Block* next = head->next;
+            upstream->deallocate(head, head->size,
+                    alignof(std::max_align_t));
+            head = next;
+        }
+
+        current = last = nullptr;
+        used = 0;
+    }
+
+
+    inline size_t ArenaResource::bytesInUse() const noexcept{
+        return used;
+    }
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	           Class PoolResource             ||
+    //					          ||
+    //--------------------------------------------||
+
+    inline PoolResource::PoolResource(MemoryResource* source):
+        chunks(nullptr), upstream(source){
+            for (size_t i=0; i < CLASSES; ++i){
+                freeList[i] = nullptr;
+            }
+        }
+
+
+    inline PoolResource::~PoolResource(){
+        release();
+    }
+
+
+    inline size_t PoolResource::sizeClass(size_t bytes) noexcept{
+        size_t index = 0;
+        size_t size = MIN_BLOCK;
+
+        while (size < bytes){
+            size <<= 1;
+            ++index;
+        }
+
+        return index;
+    }
+
+
+    inline void* PoolResource::allocate(size_t bytes, size_t alignment){
+        if (bytes > MAX_BLOCK || alignment > alignof(std::max_align_t)){
+            return upstream->allocate(bytes, alignment);
+        }
+
+        size_t index = sizeClass(bytes);
+
+        if (freeList[index] == nullptr){
+            refill(index);
+        }
+
+        FreeBlock* block = freeList[index];
+        freeList[index] = block->next;
+
+        return block;
+    }
+
+
+    inline void PoolResource::deallocate(void* block, size_t bytes,
+            size_t alignment) noexcept{
+        if (block == nullptr){
+            return;
+        }
+
+        if (bytes > MAX_BLOCK || alignment > alignof(std::max_align_t)){
+            upstream->deallocate(block, bytes, alignment);
+            return;
+        }
+
+        size_t index = sizeClass(bytes);
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->next = freeList[index];
+        freeList[index] = freed;
+    }
+
+
+    inline void PoolResource::refill(size_t index){
+        // Every chunk holds at least 32 blocks of the class
+        const size_t header = detail::HeaderSize<Chunk>::value;
+        size_t blockBytes = MIN_BLOCK << index;
+        size_t count = (blockBytes * 32 < MAX_BLOCK * 4) ?
+            (MAX_BLOCK * 4) / blockBytes : 32;
+        size_t size = header + blockBytes * count;
+
+        Chunk* chunk = static_cast<Chunk*>(
+                upstream->allocate(size, alignof(std::max_align_t)));
+        chunk->next = chunks;
+        chunk->size = size;
+        chunks = chunk;
+
+        unsigned char* start = reinterpret_cast<unsigned char*>(chunk) +
+            header;
+
+        for (size_t i=count; i > 0; --i){
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(
+                    start + (i-1) * blockBytes);
+            block->next = freeList[index];
+            freeList[index] = block;
+        }
+    }
+
+
+    inline void PoolResource::release() noexcept{
+        while (chunks != nullptr){
+            Chunk* next = chunks->next;
+            upstream->deallocate(chunks, chunks->size,
+                    alignof(std::max_align_t));
+            chunks = next;
+        }
+
+        for (size_t i=0; i < CLASSES; ++i){
+            freeList[i] = nullptr;
+        }
+    }
+
+    //--------------------------------------------||
+    //						  ||
+    // 	          Class AlignedResource           ||
+    //					          ||
+    //--------------------------------------------||
+
+    inline AlignedResource::AlignedResource(size_t alignment,
+            MemoryResource* source) noexcept: minimum(alignment),
+    upstream(source){}
+
+
+    inline void* AlignedResource::allocate(size_t bytes, size_t alignment){
+        size_t used = (alignment > minimum) ? alignment : minimum;
+        return upstream->allocate(detail::alignUp(bytes, used), used);
+    }
+
+
+    inline void AlignedResource::deallocate(void* block, size_t bytes,
+            size_t alignment) noexcept{
+        size_t used = (alignment > minimum) ? alignment : minimum;
+        upstream->deallocate(block, detail::alignUp(bytes, used), used);
+    }
+
+
+    inline size_t AlignedResource::alignment() const noexcept{
+        return minimum;
+    }
+
+
+    template <size_t ALIGN>
+        MemoryResource* alignedResource() noexcept{
+            static_assert(ALIGN > 0 && (ALIGN & (ALIGN - 1)) == 0,
+                    "The alignment must be a power of two");
+            static AlignedResource resource(ALIGN);
+            return &resource;
+        }
+
+
+    //--------------------------------------------||
+    //						  ||
+    // 	          Class HugePageResource          ||
+    //					          ||
+    //--------------------------------------------||
+
+    inline HugePageResource::HugePageResource(size_t size,
+            MemoryResource* source) noexcept: threshold(size),
+    upstream(source){}
+
+
+    inline bool HugePageResource::mapped(size_t bytes) const noexcept{
+#ifdef ZH_HAVE_MMAN
+        return bytes >= threshold;
+#else
+        (void) bytes;
+        return false;
+#endif
+    }
+
+
+    inline void* HugePageResource::allocate(size_t bytes, size_t alignment){
+        if (!mapped(bytes) || alignment > HUGE_PAGE){
+            return upstream->allocate(bytes, alignment);
+        }
+
+#ifdef ZH_HAVE_MMAN
+        // Map one huge page more than needed and unmap what lies
+        // before and after the first 2 MiB boundary
+        size_t size = detail::alignUp(bytes, HUGE_PAGE);
+        void* raw = mmap(nullptr, size + HUGE_PAGE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (raw == MAP_FAILED){
+            throw bad_alloc();
+        }
+
+        std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t start = detail::alignUp(first, HUGE_PAGE);
+
+        if (start > first){
+            munmap(raw, start - first);
+        }
+
+        if (first + HUGE_PAGE > start){
+            munmap(reinterpret_cast<void*>(start + size),
+                    first + HUGE_PAGE - start);
+        }
+
+#ifdef MADV_HUGEPAGE
+        // Only advice, without transparent huge pages the block
+        // still works with normal pages
+        madvise(reinterpret_cast<void*>(start), size, MADV_HUGEPAGE);
+#endif
+
+        return reinterpret_cast<void*>(start);
+#else
+        return upstream->allocate(bytes, alignment);
+#endif
+    }
+
+
+    inline void HugePageResource::deallocate(void* block, size_t bytes,
+            size_t alignment) noexcept{
+        if (!mapped(bytes) || alignment > HUGE_PAGE){
+            upstream->deallocate(block, bytes, alignment);
+            return;
+        }
+
+#ifdef ZH_HAVE_MMAN
+        munmap(block, detail::alignUp(bytes, HUGE_PAGE));
+#endif
+    }
+
+
+    inline MemoryResource* hugePageResource() noexcept{
+        static HugePageResource resource;
+        return &resource;
+    }
+
+} // namespace zh
+
+#endif /* ifndef MEMRESOURCE */
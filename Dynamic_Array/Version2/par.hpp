@@ -0,0 +1,739 @@
+/*
+ * Filename:      par.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (08:10 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PAR
+#define PAR
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+
+namespace zh{
+
+    namespace par{
+
+
+        //============================================||
+        //					              ||
+        // 		       Prototype 	              ||
+        //					              ||
+        //============================================||
+
+        /*  // Summary of available services
+         *
+         *  Algorithms over contiguous ranges such as
+         *  [DArray<T>::begin(), DArray<T>::end()), split into one
+         *  part per thread of defaultPool(). Ranges shorter than
+         *  serialThreshold() run on the calling thread only.
+         *
+         *  void for_each(T*, T*, F);
+         *  void transform(const T*, const T*, U*, F);
+         *  T reduce(const T*, const T*, T, Op);
+         *  void inclusive_scan(const T*, const T*, T*, Op);
+         *  void sort(T*, T*);
+         *  void sort(T*, T*, Compare);
+         *
+         *  size_t serialThreshold();
+         *  void setSerialThreshold(size_t);
+         *  ThreadPool& defaultPool();
+         *  void usePool(ThreadPool&);
+         *
+         *  Remark: Programs using this header link with -pthread
+         */
+
+
+        class ThreadPool{
+
+            public:
+
+                explicit ThreadPool(unsigned threads =
+                        std::thread::hardware_concurrency());
+                /*
+                 *  Description: Start a pool in which threads jobs
+                 *               can run at the same time, the
+                 *               calling thread of run() being one
+                 *               of them
+                 *
+                 *  Input: 1) Number of threads, 0 is treated as 1
+                 *
+                 *  Exception: 1) OutOfMemory() or std::system_error
+                 *                if a worker can't be started, the
+                 *                workers already running are stopped
+                 *                and joined first
+                 */
+
+
+                ~ThreadPool();
+                /*
+                 *  Description: Stops and joins every worker
+                 *
+                 *  Pre-condition: 1) No run() is in progress
+                 */
+
+
+                ThreadPool(const ThreadPool&) = delete;
+                ThreadPool& operator=(const ThreadPool&) = delete;
+
+
+                unsigned concurrency() const noexcept;
+                /*
+                 *  Description: Returns the number of jobs that can
+                 *               run at the same time
+                 */
+
+
+                template <typename F>
+                    void run(size_t, F);
+                /*
+                 *  Description: Calls job(0), ..., job(tasks - 1) on
+                 *               the workers and the calling thread
+                 *               and returns when all of them are
+                 *               done
+                 *
+                 *  Input: 1) Number of tasks
+                 *         2) Function object taking a task number
+                 *
+                 *  Exception: 1) The first exception thrown by a
+                 *                task, after all tasks are done
+                 *
+                 *  Remark: run() may be called from inside a task,
+                 *          the calling thread keeps working instead
+                 *          of waiting so it cannot deadlock
+                 */
+
+
+            private:
+
+                template <typename F>
+                    struct Batch{
+                        Batch(size_t count, F& function):
+                            job(function), tasks(count), next(0),
+                            finished(0){}
+
+                        F& job;
+                        size_t tasks;
+                        std::atomic<size_t> next;
+                        size_t finished;
+                        std::exception_ptr error;
+                        std::mutex lock;
+                        std::condition_variable allDone;
+                    };
+
+                template <typename F>
+                    static void drain(Batch<F>&);
+
+                void workerLoop();
+
+                void stopWorkers() noexcept;
+
+
+                std::deque<std::function<void()> > queue;
+                std::mutex queueLock;
+                std::condition_variable queueReady;
+                DArray<std::thread> workers;
+                bool stopping;
+        };
+
+
+        ThreadPool& defaultPool();
+        /*
+         *  Description: Returns the pool used by the algorithms of
+         *               this header, by default one thread per
+         *               hardware thread
+         */
+
+
+        void usePool(ThreadPool&) noexcept;
+        /*
+         *  Description: Make the algorithms of this header run on the
+         *               given pool
+         *
+         *  Pre-condition: 1) The pool outlives its use, and no
+         *                    algorithm is running
+         */
+
+
+        size_t serialThreshold() noexcept;
+
+        void setSerialThreshold(size_t) noexcept;
+        /*
+         *  Description: Ranges with fewer objects than the threshold
+         *               (default 32768) are processed serially, and
+         *               longer ranges get at most one part per
+         *               threshold objects
+         */
+
+
+        template <typename T, typename F>
+            void for_each(T*, T*, F);
+        /*
+         *  Description: Calls f(object) for every object of the range
+         *
+         *  Pre-condition: 1) f may be called concurrently
+         *
+         *  Remark: Best & Worst case: O(n / threads)
+         */
+
+
+        template <typename T, typename U, typename F>
+            void transform(const T*, const T*, U*, F);
+        /*
+         *  Description: out[i] = f(first[i]) for every object of
+         *               [first, last)
+         *
+         *  Pre-condition: 1) out is first or the output range does
+         *                    not overlap the input
+         */
+
+
+        template <typename T, typename Op>
+            T reduce(const T*, const T*, T, Op);
+        /*
+         *  Description: Returns init combined with every object of
+         *               the range using op
+         *
+         *  Pre-condition: 1) op is associative, the grouping of the
+         *                    objects depends on the number of parts
+         *
+         *  Remark: Best & Worst case: O(n / threads + threads)
+         */
+
+
+        template <typename T, typename Op>
+            void inclusive_scan(const T*, const T*, T*, Op);
+        /*
+         *  Description: out[i] = first[0] op ... op first[i]
+         *
+         *  Pre-condition: 1) op is associative
+         *                 2) out is first or the output range does
+         *                    not overlap the input
+         *
+         *  Remark: Reads the input twice, best & worst case:
+         *          O(n / threads + threads)
+         */
+
+
+        template <typename T>
+            void sort(T*, T*);
+
+        template <typename T, typename Compare>
+            void sort(T*, T*, Compare);
+        /*
+         *  Description: Sort the range in ascending order by
+         *               operator< (by comp)
+         *
+         *  Exception: 1) OutOfMemory() if the scratch buffer can't
+         *                be allocated
+         *
+         *  Remark: Not stable. Every part is sorted with std::sort,
+         *          then pairs of sorted runs are merged, each merge
+         *          split across the threads. Needs a scratch buffer
+         *          of n objects, O(n log n / threads + n log threads)
+         */
+
+
+    } // namespace par
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    namespace par{
+
+        inline ThreadPool::ThreadPool(unsigned threads):
+            stopping(false){
+                if (threads > 1){
+                    // Reserved first so append() can't throw with
+                    // a started thread in hand
+                    workers.reserve(threads - 1);
+                }
+
+                try{
+                    // The thread calling run() is the last worker
+                    for (unsigned i=1; i < threads; ++i){
+                        workers.append(std::thread(&ThreadPool::workerLoop,
+                                    this));
+                    }
+                }catch (...){
+                    // A joinable std::thread can't be destroyed
+                    stopWorkers();
+                    throw;
+                }
+            }
+
+
+        inline ThreadPool::~ThreadPool(){
+            stopWorkers();
+        }
+
+
+        inline void ThreadPool::stopWorkers() noexcept{
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                stopping = true;
+            }
+            queueReady.notify_all();
+
+            for (size_t i=0; i < workers.size(); ++i){
+                workers[i].join();
+            }
+        }
+
+
+        inline unsigned ThreadPool::concurrency() const noexcept{
+            return static_cast<unsigned>(workers.size()) + 1;
+        }
+
+
+        inline void ThreadPool::workerLoop(){
+            for (;;){
+                std::function<void()> item;
+                {
+                    std::unique_lock<std::mutex> guard(queueLock);
+                    queueReady.wait(guard, [this](){
+                            return stopping || !queue.empty();});
+
+                    if (queue.empty()){
+                        return;
+                    }
+
+                    item = std::move(queue.front());
+                    queue.pop_front();
+                }
+                item();
+            }
+        }
+
+
+        template <typename F>
+            void ThreadPool::drain(Batch<F>& batch){
+                // Claim task numbers until none are left
+                for (;;){
+                    size_t task = batch.next.fetch_add(1);
+
+                    if (task >= batch.tasks){
+                        return;
+                    }
+
+                    try{
+                        batch.job(task);
+                    }catch (...){
+                        std::lock_guard<std::mutex> guard(batch.lock);
+                        if (!batch.error){
+                            batch.error = std::current_exception();
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> guard(batch.lock);
+                    if (++batch.finished == batch.tasks){
+                        batch.allDone.notify_all();
+                    }
+                }
+            }
+
+
+        template <typename F>
+            void ThreadPool::run(size_t tasks, F job){
+                if (tasks == 0){
+                    return;
+                }
+
+                // Workers may pick up their entry after run() has
+                // returned, the shared_ptr keeps the batch alive
+                auto batch = std::make_shared<Batch<F> >(tasks, job);
+                size_t helpers = std::min<size_t>(workers.size(),
+                        tasks - 1);
+
+                if (helpers > 0){
+                    {
+                        std::lock_guard<std::mutex> guard(queueLock);
+                        for (size_t i=0; i < helpers; ++i){
+                            queue.push_back([batch](){ drain(*batch);});
+                        }
+                    }
+                    queueReady.notify_all();
+                }
+
+                drain(*batch);
+
+                std::unique_lock<std::mutex> guard(batch->lock);
+                batch->allDone.wait(guard, [&batch](){
+                        return batch->finished == batch->tasks;});
+
+                if (batch->error){
+                    std::rethrow_exception(batch->error);
+                }
+            }
+
+
+        namespace detail{
+
+            inline std::atomic<ThreadPool*>& currentPool() noexcept{
+                static std::atomic<ThreadPool*> pool(nullptr);
+                return pool;
+            }
+
+
+            inline std::atomic<size_t>& threshold() noexcept{
+                static std::atomic<size_t> value(32768);
+                return value;
+            }
+
+
+            inline size_t partsFor(size_t length){
+                // Returns 1 when the range should run serially
+                size_t grain = threshold().load(std::memory_order_relaxed);
+                if (grain == 0){
+                    grain = 1;
+                }
+
+                // Small ranges never touch, or start, the pool
+                size_t parts = length / grain;
+                if (parts < 2){
+                    return 1;
+                }
+
+                return std::min<size_t>(parts, defaultPool().concurrency());
+            }
+
+
+            inline size_t bound(size_t length, size_t parts, size_t part){
+                // First index of part, parts are within one object
+                // of the same length
+                return length / parts * part +
+                    std::min(part, length % parts);
+            }
+
+
+            template <typename T, typename Compare>
+                size_t coRank(size_t k, const T* a, size_t m,
+                        const T* b, size_t n, Compare comp){
+                    // Returns how many objects of a are among the
+                    // first k objects of the stable merge of a and b
+                    size_t low = (k > n) ? k - n : 0;
+                    size_t high = std::min(k, m);
+
+                    while (low < high){
+                        size_t i = low + (high - low) / 2;
+                        size_t j = k - i;
+
+                        if (j > 0 && !comp(b[j-1], a[i])){
+                            low = i + 1;
+                        }else {
+                            high = i;
+                        }
+                    }
+
+                    return low;
+                }
+
+
+            template <typename T, typename Compare>
+                void mergeRuns(T* from, T* to, size_t length, size_t parts,
+                        size_t width, Compare comp){
+                    // A run is width consecutive parts of bound(). Merge
+                    // run 2r with run 2r+1 of from into to, for every r.
+                    // The output of each pair is split into pieces so
+                    // all threads take part in the last merges too
+                    size_t runs = (parts + width - 1) / width;
+                    size_t pairs = (runs + 1) / 2;
+                    size_t pieces = std::max<size_t>(1, parts / pairs);
+
+                    defaultPool().run(pairs * pieces, [=](size_t task){
+                            size_t pair = task / pieces;
+                            size_t piece = task % pieces;
+                            size_t begin = bound(length, parts,
+                                    2 * pair * width);
+                            size_t middle = bound(length, parts,
+                                    std::min((2 * pair + 1) * width, parts));
+                            size_t end = bound(length, parts,
+                                    std::min((2 * pair + 2) * width, parts));
+
+                            const T* a = from + begin;
+                            const T* b = from + middle;
+                            size_t m = middle - begin;
+                            size_t n = end - middle;
+                            size_t first = bound(m + n, pieces, piece);
+                            size_t last = bound(m + n, pieces, piece + 1);
+                            size_t i = coRank(first, a, m, b, n, comp);
+                            size_t j = coRank(last, a, m, b, n, comp);
+
+                            std::merge(
+                                std::make_move_iterator(from + begin + i),
+                                std::make_move_iterator(from + begin + j),
+                                std::make_move_iterator(from + middle +
+                                    first - i),
+                                std::make_move_iterator(from + middle +
+                                    last - j),
+                                to + begin + first, comp);
+                        });
+                }
+
+        } // namespace detail
+
+
+        inline ThreadPool& defaultPool(){
+            ThreadPool* pool =
+                detail::currentPool().load(std::memory_order_acquire);
+
+            if (pool == nullptr){
+                // Started once, by whichever thread gets here first,
+                // and only installed if usePool() wasn't called
+                static ThreadPool fallback;
+                ThreadPool* expected = nullptr;
+
+                if (detail::currentPool().compare_exchange_strong(expected,
+                            &fallback, std::memory_order_acq_rel,
+                            std::memory_order_acquire)){
+                    pool = &fallback;
+                }else {
+                    pool = expected;
+                }
+            }
+
+            return *pool;
+        }
+
+
+        inline void usePool(ThreadPool& pool) noexcept{
+            detail::currentPool().store(&pool, std::memory_order_release);
+        }
+
+
+        inline size_t serialThreshold() noexcept{
+            return detail::threshold().load(std::memory_order_relaxed);
+        }
+
+
+        inline void setSerialThreshold(size_t value) noexcept{
+            detail::threshold().store(value, std::memory_order_relaxed);
+        }
+
+
+        template <typename T, typename F>
+            void for_each(T* first, T* last, F f){
+                size_t length = last - first;
+                size_t parts = detail::partsFor(length);
+
+                if (parts == 1){
+                    for (T* p = first; p != last; ++p){
+                        f(*p);
+                    }
+                    return;
+                }
+
+                defaultPool().run(parts, [=](size_t part){
+                        T* stop = first + detail::bound(length, parts,
+                                part + 1);
+                        for (T* p = first + detail::bound(length, parts,
+                                    part); p != stop; ++p){
+                            f(*p);
+                        }
+                    });
+            }
+
+
+        template <typename T, typename U, typename F>
+            void transform(const T* first, const T* last, U* out, F f){
+                size_t length = last - first;
+                size_t parts = detail::partsFor(length);
+
+                defaultPool().run(parts, [=](size_t part){
+                        size_t stop = detail::bound(length, parts, part + 1);
+                        for (size_t i = detail::bound(length, parts, part);
+                                i < stop; ++i){
+                            out[i] = f(first[i]);
+                        }
+                    });
+            }
+
+
+        template <typename T, typename Op>
+            T reduce(const T* first, const T* last, T init, Op op){
+                static_assert(!std::is_same<T, bool>::value, "The parts "
+                    "need a DArray<bool> buffer, which holds bits, use "
+                    "unsigned char");
+                size_t length = last - first;
+                size_t parts = detail::partsFor(length);
+
+                if (parts == 1){
+                    for (const T* p = first; p != last; ++p){
+                        init = op(init, *p);
+                    }
+                    return init;
+                }
+
+                // Every part starts from its own first object so init
+                // is used exactly once
+                DArray<T> partial(parts, init);
+                T* results = partial.begin();
+
+                defaultPool().run(parts, [=](size_t part){
+                        size_t start = detail::bound(length, parts, part);
+                        size_t stop = detail::bound(length, parts, part + 1);
+                        T value = first[start];
+                        for (size_t i = start + 1; i < stop; ++i){
+                            value = op(value, first[i]);
+                        }
+                        results[part] = value;
+                    });
+
+                for (size_t part=0; part < parts; ++part){
+                    init = op(init, results[part]);
+                }
+
+                return init;
+            }
+
+
+        template <typename T, typename Op>
+            void inclusive_scan(const T* first, const T* last, T* out,
+                    Op op){
+                static_assert(!std::is_same<T, bool>::value, "The parts "
+                    "need a DArray<bool> buffer, which holds bits, use "
+                    "unsigned char");
+                size_t length = last - first;
+
+                if (length == 0){
+                    return;
+                }
+
+                size_t parts = detail::partsFor(length);
+
+                if (parts == 1){
+                    T running = first[0];
+                    out[0] = running;
+                    for (size_t i=1; i < length; ++i){
+                        running = op(running, first[i]);
+                        out[i] = running;
+                    }
+                    return;
+                }
+
+                // 1) Total of every part but the last
+                DArray<T> offsets(parts, first[0]);
+                T* totals = offsets.begin();
+
+                defaultPool().run(parts - 1, [=](size_t part){
+                        size_t start = detail::bound(length, parts, part);
+                        size_t stop = detail::bound(length, parts, part + 1);
+                        T value = first[start];
+                        for (size_t i = start + 1; i < stop; ++i){
+                            value = op(value, first[i]);
+                        }
+                        totals[part + 1] = value;
+                    });
+
+                // 2) totals[p] becomes the combined total of parts
+                //    [0, p), totals[0] is unused
+                for (size_t part=2; part < parts; ++part){
+                    totals[part] = op(totals[part-1], totals[part]);
+                }
+
+                // 3) Scan every part starting from its offset
+                defaultPool().run(parts, [=](size_t part){
+                        size_t start = detail::bound(length, parts, part);
+                        size_t stop = detail::bound(length, parts, part + 1);
+                        T running = (part == 0) ? first[start] :
+                            op(totals[part], first[start]);
+                        out[start] = running;
+                        for (size_t i = start + 1; i < stop; ++i){
+                            running = op(running, first[i]);
+                            out[i] = running;
+                        }
+                    });
+            }
+
+
+        template <typename T>
+            void sort(T* first, T* last){
+                sort(first, last, std::less<T>());
+            }
+
+
+        template <typename T, typename Compare>
+            void sort(T* first, T* last, Compare comp){
+                static_assert(!std::is_same<T, bool>::value, "The parts "
+                    "need a DArray<bool> buffer, which holds bits, use "
+                    "unsigned char");
+                size_t length = last - first;
+                size_t parts = detail::partsFor(length);
+
+                if (parts == 1){
+                    std::sort(first, last, comp);
+                    return;
+                }
+
+                defaultPool().run(parts, [=](size_t part){
+                        std::sort(first + detail::bound(length, parts, part),
+                                first + detail::bound(length, parts,
+                                    part + 1), comp);
+                    });
+
+                // The sorted runs are moved into the scratch, which
+                // leaves moved-from objects in the input for the
+                // first merge to assign into
+                DArray<T> scratch;
+                scratch.reserve(length);
+                scratch.append(std::make_move_iterator(first),
+                        std::make_move_iterator(last));
+
+                T* from = scratch.begin();
+                T* to = first;
+
+                for (size_t width=1; width < parts; width *= 2){
+                    detail::mergeRuns(from, to, length, parts, width, comp);
+                    std::swap(from, to);
+                }
+
+                if (from != first){
+                    T* source = from;
+                    for_each(first, last, [source, first](T& item){
+                            item = std::move(source[&item - first]);
+                        });
+                }
+            }
+
+    } // namespace par
+
+} // namespace zh
+
+#endif /* ifndef PAR */
@@ -0,0 +1,394 @@
+/*
+ * Filename:      radixsort.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:50 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef RADIXSORT
+#define RADIXSORT
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    /*  // Summary of available services
+     *
+     *  Sorts that never compare: the keys are split into digits
+     *  and the objects distributed by digit. Both are stable and
+     *  use a single scratch DArray of the same size, taken from the
+     *  memory resource of the sorted array. Keys are integers of
+     *  any size and sign, float or double.
+     *
+     *  template <typename T, typename G>
+     *      void radix_sort(DArray<T,G>&);
+     *
+     *  template <typename T, typename G, typename KeyOf>
+     *      void radix_sort(DArray<T,G>&, KeyOf);
+     *
+     *  template <typename T, typename G>
+     *      void counting_sort(DArray<T,G>&);
+     *
+     *  template <typename T, typename G, typename KeyOf>
+     *      void counting_sort(DArray<T,G>&, KeyOf);
+     */
+
+
+    template <typename T, typename G>
+        void radix_sort(DArray<T,G>&);
+
+    template <typename T, typename G, typename KeyOf>
+        void radix_sort(DArray<T,G>&, KeyOf);
+    /*
+     *  Description: Sort the array in ascending order of the
+     *               objects, or of the key returned by keyOf(object)
+     *               for records. Objects with equal keys keep their
+     *               order
+     *
+     *  Pre-condition: 1) <T> is default constructible and move
+     *                    assignable (the scratch array is resized)
+     *                 2) Float keys are not NaN, -0.0 sorts before
+     *                    0.0
+     *
+     *  Exception: 1) OutOfMemory() if the scratch array can't be
+     *                allocated, the array is unchanged
+     *
+     *  Remark: Best & Worst case: O(n * sizeof(key)). One pass
+     *          counts every digit of every key, then one pass per
+     *          byte of the key distributes the objects. A byte that
+     *          is the same in every key (the high bytes of small
+     *          numbers) is skipped
+     */
+
+
+    template <typename T, typename G>
+        void counting_sort(DArray<T,G>&);
+
+    template <typename T, typename G, typename KeyOf>
+        void counting_sort(DArray<T,G>&, KeyOf);
+    /*
+     *  Description: Sort the array by an integer key whose values
+     *               lie close together (ages, small enums, bytes).
+     *               Every key value gets a counter; plain integers
+     *               are then rewritten from the counters without
+     *               moving anything, records are distributed stably
+     *
+     *  Exception: 1) OutOfMemory() if the counters or the scratch
+     *                array can't be allocated
+     *
+     *  Remark: Best & Worst case: O(n + k) for k distinct key
+     *          values between the smallest and largest key. When k
+     *          is more than 2n + 65536 the array is radix sorted
+     *          instead
+     */
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        // Order preserving map of a key to an unsigned integer of
+        // the same size: the sign bit of signed integers is
+        // flipped, negative floats have every bit flipped and
+        // positive ones only the sign bit
+
+        template <typename K, typename = void>
+            struct RadixKey;
+
+        template <typename K>
+            struct RadixKey<K, typename std::enable_if<
+            std::is_integral<K>::value && !std::is_same<K, bool>::value>
+            ::type>{
+
+                typedef typename std::make_unsigned<K>::type type;
+
+                static const type SIGN = std::is_signed<K>::value ?
+                    static_cast<type>(type(1) << (sizeof(K) * 8 - 1)) : 0;
+
+                static type bits(K key) noexcept{
+                    return static_cast<type>(key) ^ SIGN;
+                }
+
+                static K value(type bits) noexcept{
+                    return static_cast<K>(static_cast<type>(bits ^ SIGN));
+                }
+            };
+
+        template <typename K>
+            struct RadixKey<K, typename std::enable_if<
+            std::is_floating_point<K>::value>::type>{
+
+                typedef typename std::conditional<sizeof(K) == 4,
+                        unsigned int, unsigned long long>::type type;
+
+                static_assert(sizeof(K) == sizeof(type),
+                        "Only float and double keys can be radix sorted");
+
+                static type bits(K key) noexcept{
+                    type raw;
+                    std::memcpy(&raw, &key, sizeof(K));
+
+                    type sign = type(1) << (sizeof(K) * 8 - 1);
+                    return (raw & sign) ? ~raw : (raw | sign);
+                }
+            };
+
+
+        struct Identity{
+            template <typename T>
+                const T& operator()(const T& item) const noexcept{
+                    return item;
+                }
+        };
+
+
+        template <typename T, typename KeyOf>
+            struct KeyType{
+                typedef typename std::decay<decltype(std::declval<KeyOf&>()(
+                            std::declval<const T&>()))>::type type;
+            };
+
+    } // namespace detail
+
+
+    template <typename T, typename G>
+        void radix_sort(DArray<T,G>& items){
+            radix_sort(items, detail::Identity());
+        }
+
+
+    template <typename T, typename G, typename KeyOf>
+        void radix_sort(DArray<T,G>& items, KeyOf keyOf){
+            static_assert(!std::is_same<T, bool>::value, "DArray<bool> "
+                    "holds bits and can't be radix sorted, use "
+                    "DArray<unsigned char>");
+
+            typedef typename detail::KeyType<T, KeyOf>::type K;
+            typedef detail::RadixKey<K> Radix;
+            typedef typename Radix::type U;
+
+            const size_t DIGITS = sizeof(U);
+            size_t length = items.size();
+
+            if (length < 2){
+                return;
+            }
+
+            // Histograms of all digits in one pass
+            size_t counts[DIGITS][256] = {};
+            const T* source = items.begin();
+
+            for (size_t i=0; i < length; ++i){
+                U bits = Radix::bits(keyOf(source[i]));
+
+                for (size_t d=0; d < DIGITS; ++d){
+                    ++counts[d][(bits >> (8 * d)) & 0xFF];
+                }
+            }
+
+            U firstBits = Radix::bits(keyOf(source[0]));
+            // Resized once, the two buffers are then used in turns
+            DArray<T,G> scratch(*items.resource());
+            scratch.resize(length);
+
+            T* from = items.begin();
+            T* to = scratch.begin();
+            bool inScratch = false;
+
+            for (size_t d=0; d < DIGITS; ++d){
+                size_t shift = 8 * d;
+
+                if (counts[d][(firstBits >> shift) & 0xFF] == length){
+                    continue;
+                }
+
+                size_t offsets[256];
+                size_t total = 0;
+
+                for (size_t b=0; b < 256; ++b){
+                    offsets[b] = total;
+                    total += counts[d][b];
+                }
+
+                for (size_t i=0; i < length; ++i){
+                    size_t digit = (Radix::bits(keyOf(from[i])) >> shift) &
+                        0xFF;
+                    to[offsets[digit]++] = std::move(from[i]);
+                }
+
+                std::swap(from, to);
+                inScratch = !inScratch;
+            }
+
+            // After an odd number of passes the sorted objects are
+            // in the scratch array, both arrays share a resource so
+            // their buffers can simply be exchanged
+            if (inScratch){
+                std::swap(items, scratch);
+            }
+        }
+
+
+    template <typename T, typename G>
+        void counting_sort(DArray<T,G>& items){
+            static_assert(std::is_integral<T>::value, "counting_sort() "
+                    "without a key needs integers, use a key extractor "
+                    "for records");
+            static_assert(!std::is_same<T, bool>::value, "DArray<bool> "
+                    "holds bits and can't be counting sorted, use "
+                    "DArray<unsigned char>");
+
+            typedef detail::RadixKey<T> Radix;
+            typedef typename Radix::type U;
+
+            size_t length = items.size();
+
+            if (length < 2){
+                return;
+            }
+
+            T* item = items.begin();
+            U lowest = Radix::bits(item[0]);
+            U highest = lowest;
+
+            for (size_t i=1; i < length; ++i){
+                U bits = Radix::bits(item[i]);
+                lowest = bits < lowest ? bits : lowest;
+                highest = bits > highest ? bits : highest;
+            }
+
+            // Small unsigned types are promoted, hence the cast
+            size_t range = static_cast<U>(highest - lowest);
+
+            if (range > 2 * length + 65536){
+                radix_sort(items);
+                return;
+            }
+
+            DArray<size_t> counts(range + 1, 0);
+            size_t* count = counts.begin();
+
+            for (size_t i=0; i < length; ++i){
+                ++count[Radix::bits(item[i]) - lowest];
+            }
+
+            // Equal integers can't be told apart, writing every
+            // value count times is the sorted array
+            size_t next = 0;
+
+            for (size_t v=0; v < counts.size(); ++v){
+                T value = Radix::value(static_cast<U>(lowest + v));
+
+                for (size_t c = count[v]; c > 0; --c){
+                    item[next++] = value;
+                }
+            }
+        }
+
+
+    template <typename T, typename G, typename KeyOf>
+        void counting_sort(DArray<T,G>& items, KeyOf keyOf){
+            static_assert(!std::is_same<T, bool>::value, "DArray<bool> "
+                    "holds bits and can't be counting sorted, use "
+                    "DArray<unsigned char>");
+
+            typedef typename detail::KeyType<T, KeyOf>::type K;
+            static_assert(std::is_integral<K>::value,
+                    "counting_sort() needs integer keys");
+
+            typedef detail::RadixKey<K> Radix;
+            typedef typename Radix::type U;
+
+            size_t length = items.size();
+
+            if (length < 2){
+                return;
+            }
+
+            const T* source = items.begin();
+            U lowest = Radix::bits(keyOf(source[0]));
+            U highest = lowest;
+
+            for (size_t i=1; i < length; ++i){
+                U bits = Radix::bits(keyOf(source[i]));
+                lowest = bits < lowest ? bits : lowest;
+                highest = bits > highest ? bits : highest;
+            }
+
+            // Small unsigned types are promoted, hence the cast
+            size_t range = static_cast<U>(highest - lowest);
+
+            if (range > 2 * length + 65536){
+                radix_sort(items, keyOf);
+                return;
+            }
+
+            DArray<size_t> counts(range + 1, 0);
+            size_t* offset = counts.begin();
+
+            for (size_t i=0; i < length; ++i){
+                ++offset[Radix::bits(keyOf(source[i])) - lowest];
+            }
+
+            size_t total = 0;
+
+            for (size_t v=0; v < counts.size(); ++v){
+                size_t here = offset[v];
+                offset[v] = total;
+                total += here;
+            }
+
+            DArray<T,G> scratch(*items.resource());
+            scratch.resize(length);
+
+            T* from = items.begin();
+            T* to = scratch.begin();
+
+            for (size_t i=0; i < length; ++i){
+                to[offset[Radix::bits(keyOf(from[i])) - lowest]++] =
+                    std::move(from[i]);
+            }
+
+            std::swap(items, scratch);
+        }
+
+} // namespace zh
+
+#endif /* ifndef RADIXSORT */
@@ -0,0 +1,611 @@
+/*
+ * Filename:      segarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sat Oct 17, 2026 (06:40 PM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SEGARRAY
+#define SEGARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+using std::ptrdiff_t;
+#include <new>
+using std::bad_alloc;
+#include <utility>
+#include <iterator>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        template <size_t N>
+            struct Log2{
+                static const size_t value = 1 + Log2<N / 2>::value;
+            };
+
+        template <>
+            struct Log2<1>{
+                static const size_t value = 0;
+            };
+
+    } // namespace detail
+
+
+    template <typename T, size_t CHUNK = 1024>
+        class SegmentedArray{
+
+            /*  // Summary of available services
+             *
+             *  Objects are stored in chunks of CHUNK objects that
+             *  are never moved once allocated. A small directory
+             *  (a DArray of chunk pointers) maps an index to its
+             *  chunk, so growing the array only ever appends a chunk
+             *  and pointers or references to existing objects stay
+             *  valid until the object itself is removed.
+             *
+             *  SegmentedArray();
+             *
+             *  explicit SegmentedArray(MemoryResource&);
+             *
+             *  ~SegmentedArray() noexcept;
+             *
+             *  SegmentedArray(const SegmentedArray&);
+             *
+             *  SegmentedArray(SegmentedArray&&) noexcept;
+             *
+             *  SegmentedArray& operator=(const SegmentedArray&);
+             *
+             *  SegmentedArray& operator=(SegmentedArray&&) noexcept;
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  T& operator[](size_t);
+             *
+             *  const T& at(size_t) const;
+             *
+             *  T& at(size_t);
+             *
+             *  void resize(size_t, const T& = T());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void append(const T&);
+             *
+             *  void append(T&&);
+             *
+             *  template <typename... Args>
+             *      void emplace_back(Args&&...);
+             *
+             *  void remove_last();
+             *
+             *  size_t capacity() const;
+             *
+             *  void reserve(size_t);
+             *
+             *  iterator begin(); iterator end();
+             *
+             *  const_iterator begin() const; const_iterator end() const;
+             */
+
+            static_assert(CHUNK > 0 && (CHUNK & (CHUNK - 1)) == 0,
+                    "SegmentedArray needs a power of two chunk size");
+
+            template <bool CONST>
+                class Iterator;
+
+            public:
+                typedef Iterator<false> iterator;
+                typedef Iterator<true>  const_iterator;
+
+                iterator begin(){ return iterator(this, 0);};
+                iterator end(){ return iterator(this, logicalSize);};
+                const_iterator begin() const{
+                    return const_iterator(this, 0);};
+                const_iterator end() const{
+                    return const_iterator(this, logicalSize);};
+
+                SegmentedArray();
+                /*
+                 *  Description: Create an empty array, no chunk is
+                 *               allocated until the first append
+                 *
+                 *  Exception: 1) OutOfMemory() if the directory
+                 *                cannot be allocated
+                 *
+                 *  Remark: Best & Worst case: O(1)
+                 */
+
+
+                explicit SegmentedArray(MemoryResource&);
+                /*
+                 *  Description: Create an empty array whose chunks
+                 *               are obtained from the given resource
+                 *
+                 *  Pre-condition: 1) The resource outlives the array
+                 */
+
+
+                ~SegmentedArray() noexcept;
+
+
+                SegmentedArray(const SegmentedArray&);
+                /*
+                 *  Description: Copy every object of the input array
+                 *               into new chunks from the default
+                 *               memory resource
+                 *
+                 *  Exception: 1) OutOfMemory() if there is not enough
+                 *                memory
+                 */
+
+
+                SegmentedArray(SegmentedArray&&) noexcept;
+                /*
+                 *  Description: Take over the chunks of the input
+                 *               array, pointers to its objects stay
+                 *               valid and now refer to our objects
+                 */
+
+
+                SegmentedArray& operator=(const SegmentedArray&);
+
+
+                SegmentedArray& operator=(SegmentedArray&&) noexcept;
+
+
+                const T& operator[](size_t) const;
+
+                T& operator[](size_t);
+                /*
+                 *  Description: Access the object at the specified
+                 *               index with a shift and a mask, no
+                 *               division involved
+                 *
+                 *  Exception: None, checked only when
+                 *             ZH_CHECKED_ACCESS is 1 (see dynarray.hpp)
+                 *
+                 *  Remark: Best & Worst case: O(1)
+                 */
+
+
+                const T& at(size_t) const;
+
+                T& at(size_t);
+                /*
+                 *  Exception: 1) Throws InvalidIndexException() if the
+                 *                input index is equal to or greater
+                 *                than the size of the array
+                 */
+
+
+                void resize(size_t, const T& = T());
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+                /*
+                 *  Post-condition: 1) All objects are destroyed, the
+                 *                     chunks are kept for reuse
+                 */
+
+
+                void append(const T&);
+
+                void append(T&&);
+
+                template <typename... Args>
+                    void emplace_back(Args&&...);
+                /*
+                 *  Description: Construct a new object after the last
+                 *               one, allocating a new chunk if the
+                 *               last chunk is full
+                 *
+                 *  Post-condition: 1) No existing object is moved
+                 *
+                 *  Exception: 1) OutOfMemory() if a new chunk cannot
+                 *                be allocated
+                 *             2) Any exception thrown by the
+                 *                constructor of <T> is passed on
+                 *                and the array is left unchanged
+                 *
+                 *  Remark: Worst case: O(n / CHUNK), when the
+                 *          directory itself has to grow, which only
+                 *          copies chunk pointers.
+                 *          Best case: O(1)
+                 */
+
+
+                void remove_last();
+                /*
+                 *  Exception: 1) ArrayEmpty() exception is thrown
+                 *                is size of array is zero
+                 */
+
+
+                size_t capacity() const noexcept;
+                /*
+                 *  Description: Number of objects the allocated
+                 *               chunks can hold
+                 */
+
+
+                void reserve(size_t);
+                /*
+                 *  Description: Allocate chunks until at least the
+                 *               specified number of objects fit
+                 *
+                 *  Exception: 1) OutOfMemory() if a chunk cannot be
+                 *                allocated, chunks allocated before
+                 *                the failure are kept
+                 */
+
+
+            private:
+                DArray<T*> directory;
+                size_t logicalSize;
+                MemoryResource* chunkResource;
+
+                static const size_t SHIFT =
+                    detail::Log2<CHUNK>::value;
+                static const size_t MASK = CHUNK - 1;
+
+                void addChunk();
+
+                void releaseChunks() noexcept;
+        };
+
+
+    template <typename T, size_t CHUNK>
+        template <bool CONST>
+        class SegmentedArray<T,CHUNK>::Iterator{
+            // Random access iterator made of the array and an
+            // index, it stays valid while the array grows
+
+            typedef typename std::conditional<CONST,
+                    const SegmentedArray, SegmentedArray>::type Owner;
+
+            public:
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef ptrdiff_t difference_type;
+                typedef typename std::conditional<CONST,
+                        const T*, T*>::type pointer;
+                typedef typename std::conditional<CONST,
+                        const T&, T&>::type reference;
+
+                Iterator(): owner(nullptr), index(0){}
+
+                Iterator(Owner* array, size_t position):
+                    owner(array), index(position){}
+
+                // iterator converts to const_iterator
+                operator Iterator<true>() const{
+                    return Iterator<true>(owner, index);
+                }
+
+                reference operator*() const{ return (*owner)[index];}
+                pointer operator->() const{ return &(*owner)[index];}
+                reference operator[](difference_type n) const{
+                    return (*owner)[index + n];
+                }
+
+                Iterator& operator++(){ ++index; return *this;}
+                Iterator& operator--(){ --index; return *this;}
+                Iterator operator++(int){
+                    Iterator old(*this); ++index; return old;}
+                Iterator operator--(int){
+                    Iterator old(*this); --index; return old;}
+                Iterator& operator+=(difference_type n){
+                    index += n; return *this;}
+                Iterator& operator-=(difference_type n){
+                    index -= n; return *this;}
+                Iterator operator+(difference_type n) const{
+                    return Iterator(owner, index + n);}
+                Iterator operator-(difference_type n) const{
+                    return Iterator(owner, index - n);}
+                difference_type operator-(const Iterator& rhs) const{
+                    return static_cast<difference_type>(index) -
+                        static_cast<difference_type>(rhs.index);
+                }
+
+                bool operator==(const Iterator& rhs) const{
+                    return index == rhs.index && owner == rhs.owner;}
+                bool operator!=(const Iterator& rhs) const{
+                    return !(*this == rhs);}
+                bool operator<(const Iterator& rhs) const{
+                    return index < rhs.index;}
+                bool operator>(const Iterator& rhs) const{
+                    return index > rhs.index;}
+                bool operator<=(const Iterator& rhs) const{
+                    return index <= rhs.index;}
+                bool operator>=(const Iterator& rhs) const{
+                    return index >= rhs.index;}
+
+            private:
+                Owner* owner;
+                size_t index;
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>::SegmentedArray(): directory(),
+        logicalSize(0), chunkResource(newDeleteResource()){}
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>::SegmentedArray(MemoryResource& source):
+            directory(), logicalSize(0), chunkResource(&source){}
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>::~SegmentedArray() noexcept{
+            clear();
+            releaseChunks();
+        }
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>::SegmentedArray(const SegmentedArray& copy):
+            directory(), logicalSize(0), chunkResource(newDeleteResource()){
+                *this = copy;
+            }
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>::SegmentedArray(SegmentedArray&& other)
+        noexcept: directory(std::move(other.directory)),
+        logicalSize(other.logicalSize),
+        chunkResource(other.chunkResource){
+            other.logicalSize = 0;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>& SegmentedArray<T,CHUNK>::operator=(
+                const SegmentedArray& rhs){
+            if (this != &rhs){
+                clear();
+                reserve(rhs.size());
+
+                for (size_t i=0; i < rhs.size(); ++i){
+                    emplace_back(rhs[i]);
+                }
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        SegmentedArray<T,CHUNK>& SegmentedArray<T,CHUNK>::operator=(
+                SegmentedArray&& rhs) noexcept{
+            if (this != &rhs){
+                clear();
+                releaseChunks();
+
+                directory = std::move(rhs.directory);
+                logicalSize = rhs.logicalSize;
+                chunkResource = rhs.chunkResource;
+                rhs.logicalSize = 0;
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        inline const T& SegmentedArray<T,CHUNK>::operator[](
+                size_t index) const{
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize,
+                        "SegmentedArray::operator[]");
+            }
+#endif
+            return directory[index >> SHIFT][index & MASK];
+        }
+
+
+    template <typename T, size_t CHUNK>
+        inline T& SegmentedArray<T,CHUNK>::operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize,
+                        "SegmentedArray::operator[]");
+            }
+#endif
+            return directory[index >> SHIFT][index & MASK];
+        }
+
+
+    template <typename T, size_t CHUNK>
+        const T& SegmentedArray<T,CHUNK>::at(size_t index) const{
+            if (index < logicalSize){
+                return directory[index >> SHIFT][index & MASK];
+            }else{
+                throw InvalidIndexException();
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        T& SegmentedArray<T,CHUNK>::at(size_t index){
+            if (index < logicalSize){
+                return directory[index >> SHIFT][index & MASK];
+            }else{
+                throw InvalidIndexException();
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::resize(size_t inputSize,
+                const T& value){
+            if (inputSize > logicalSize){
+                reserve(inputSize);
+
+                while (logicalSize != inputSize){
+                    emplace_back(value);
+                }
+            }else{
+                while (logicalSize != inputSize){
+                    remove_last();
+                }
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        inline size_t SegmentedArray<T,CHUNK>::size() const noexcept{
+            return logicalSize;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        inline bool SegmentedArray<T,CHUNK>::isEmpty() const noexcept{
+            return logicalSize == 0;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::clear(){
+            while (logicalSize != 0){
+                remove_last();
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::append(const T& value){
+            emplace_back(value);
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::append(T&& value){
+            emplace_back(std::move(value));
+        }
+
+
+    template <typename T, size_t CHUNK>
+        template <typename... Args>
+        void SegmentedArray<T,CHUNK>::emplace_back(Args&&... args){
+            // Since nothing ever moves, the arguments can safely
+            // refer to one of our own objects
+            if (logicalSize == capacity()){
+                addChunk();
+            }
+
+            try{
+                new (directory[logicalSize >> SHIFT] + (logicalSize & MASK))
+                    T(std::forward<Args>(args)...);
+            }catch (bad_alloc){
+                throw OutOfMemory();
+            }
+
+            ++logicalSize;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::remove_last(){
+            if (isEmpty()){
+                throw ArrayEmpty();
+            }else{
+                --logicalSize;
+                (directory[logicalSize >> SHIFT] + (logicalSize & MASK))->~T();
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        inline size_t SegmentedArray<T,CHUNK>::capacity() const noexcept{
+            return directory.size() * CHUNK;
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::reserve(size_t inputSize){
+            while (capacity() < inputSize){
+                addChunk();
+            }
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::addChunk(){
+            // Make room in the directory first, so that a failure
+            // there cannot leak the new chunk
+            if (directory.size() == directory.capacity()){
+                directory.reserve(directory.size() * 2 + 1);
+            }
+
+            T* chunk = nullptr;
+
+            try{
+                chunk = static_cast<T*>(chunkResource->allocate(
+                            CHUNK * sizeof(T), alignof(T)));
+            }catch (bad_alloc){
+                throw OutOfMemory();
+            }
+
+            directory.append(chunk);
+        }
+
+
+    template <typename T, size_t CHUNK>
+        void SegmentedArray<T,CHUNK>::releaseChunks() noexcept{
+            for (size_t i=0; i < directory.size(); ++i){
+                chunkResource->deallocate(directory[i], CHUNK * sizeof(T),
+                        alignof(T));
+            }
+
+            directory.clear();
+        }
+
+} // namespace zh
+
+#endif /* ifndef SEGARRAY */
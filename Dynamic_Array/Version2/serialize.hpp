@@ -0,0 +1,595 @@
+/*
+ * Filename:      serialize.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:05 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SERIALIZE
+#define SERIALIZE
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    class StreamFailure{};
+
+
+    /*  // Summary of available services
+     *
+     *  Binary form of a DArray: a 40 byte header (magic, object
+     *  size, number of objects, payload size and a checksum of the
+     *  payload) followed by the payload. The same bytes are written
+     *  to a stream and to a file descriptor, so either side can
+     *  read what the other wrote, and several arrays can follow
+     *  each other in one stream or file.
+     *
+     *  The payload of trivially copyable objects is the buffer of
+     *  the array as it is in memory. Text types (c_str() and
+     *  length(), such as String and std::string) are written as a
+     *  length and their characters with the terminating '\0', so
+     *  types that read their input up to a '\0' (String) can be
+     *  built from it. Nested DArrays are written as a size and
+     *  their objects, to any depth. Other types are rejected at
+     *  compile time.
+     *
+     *  Like MappedDArray the bytes are in the byte order and
+     *  object layout of the machine, they are meant to be read
+     *  back by the same program on the same kind of machine.
+     *
+     *  template <typename T, typename G>
+     *      void save(const DArray<T,G>&, std::ostream&);
+     *
+     *  template <typename T, typename G>
+     *      void load(DArray<T,G>&, std::istream&);
+     *
+     *  template <typename T, typename G>
+     *      void write_to(const DArray<T,G>&, int);
+     *
+     *  template <typename T, typename G>
+     *      void read_from(DArray<T,G>&, int);
+     */
+
+
+    template <typename T, typename G>
+        void save(const DArray<T,G>&, std::ostream&);
+
+    template <typename T, typename G>
+        void write_to(const DArray<T,G>&, int);
+    /*
+     *  Description: Write the array at the current position of the
+     *               stream or file descriptor
+     *
+     *  Input: 1) Array to write
+     *         2) Binary stream, or a descriptor open for writing
+     *
+     *  Post-condition: 1) The stream or descriptor is positioned
+     *                     right after the written array
+     *
+     *  Exception: 1) StreamFailure() if the stream fails or write
+     *                reports an error, part of the array may have
+     *                been written
+     *             2) OutOfMemory() if the payload of a non trivially
+     *                copyable type can't be built
+     *
+     *  Remark: Best & Worst case: O(n). Trivially copyable objects
+     *          are not copied, the header and the buffer go to the
+     *          kernel in one writev() (repeated only if the kernel
+     *          takes less). Other types are first encoded into one
+     *          byte array, then written the same way
+     */
+
+
+    template <typename T, typename G>
+        void load(DArray<T,G>&, std::istream&);
+
+    template <typename T, typename G>
+        void read_from(DArray<T,G>&, int);
+    /*
+     *  Description: Replace the objects of the array by the array
+     *               stored at the current position of the stream or
+     *               file descriptor
+     *
+     *  Input: 1) Array to fill, its memory resource is kept
+     *         2) Binary stream, or a descriptor open for reading
+     *
+     *  Post-condition: 1) The stream or descriptor is positioned
+     *                     right after the array that was read
+     *
+     *  Exception: 1) StreamFailure() if the stream fails, read
+     *                reports an error or the input ends early
+     *             2) FormatMismatch() if the bytes were not written
+     *                by save() or write_to() of the same object
+     *                size, or the checksum does not match
+     *             3) OutOfMemory() if the objects don't fit
+     *
+     *             In every case the array is unchanged
+     *
+     *  Remark: Best & Worst case: O(n). Trivially copyable objects
+     *          are read straight into the buffer of the new array,
+     *          nothing is converted and nothing is copied a second
+     *          time
+     */
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        struct StreamHeader{
+            char magic[8];
+            std::uint64_t unitSize;
+            std::uint64_t count;
+            std::uint64_t bytes;      // Size of the payload
+            std::uint64_t checksum;   // Of the payload
+        };
+
+
+        inline std::uint64_t checksum(const void* data, size_t bytes)
+            noexcept{
+            // Fletcher style: a plain sum of the 64 bit words and a
+            // sum of those sums, which also catches words that were
+            // swapped. One add each per word, much faster than the
+            // disk or the network it guards
+            const unsigned char* at = static_cast<const unsigned char*>(
+                    data);
+            std::uint64_t low = bytes;
+            std::uint64_t high = 0;
+
+            for (; bytes >= 8; at += 8, bytes -= 8){
+                std::uint64_t word;
+                std::memcpy(&word, at, 8);
+                low += word;
+                high += low;
+            }
+
+            if (bytes > 0){
+                std::uint64_t word = 0;
+                std::memcpy(&word, at, bytes);
+                low += word;
+                high += low;
+            }
+
+            return low ^ (high * 0x9E3779B97F4A7C15ULL);
+        }
+
+
+        // How the objects of an array are encoded in the payload
+
+        struct BitwiseCoding{};
+        struct TextCoding{};
+        struct ArrayCoding{};
+
+        template <typename T>
+            struct IsDArray: std::false_type{};
+
+        template <typename T, typename G>
+            struct IsDArray<DArray<T,G> >: std::true_type{};
+
+        template <typename T>
+            struct IsBitArray: std::false_type{};
+
+        template <typename G>
+            struct IsBitArray<DArray<bool,G> >: std::true_type{};
+
+        template <typename T>
+            struct CodingOf{
+                typedef typename std::conditional<IsDArray<T>::value,
+                        ArrayCoding, typename std::conditional<
+                            IsText<T>::value, TextCoding,
+                        typename std::conditional<
+                            std::is_trivially_copyable<T>::value,
+                        BitwiseCoding, void>::type>::type>::type type;
+
+                // Checked here so every array, nested or not, stops
+                // with a readable message
+                static_assert(!std::is_same<T, bool>::value &&
+                        !IsBitArray<T>::value, "DArray<bool> holds bits "
+                        "and can't be serialized, copy the flags to a "
+                        "DArray<unsigned char>");
+                static_assert(std::is_same<T, bool>::value ||
+                        IsBitArray<T>::value || !std::is_void<type>::value,
+                        "Only trivially copyable types, text types and "
+                        "DArrays of them can be serialized");
+            };
+
+
+        typedef DArray<char> Bytes;
+
+
+        inline void appendBytes(Bytes& out, const void* data, size_t bytes){
+            const char* first = static_cast<const char*>(data);
+            out.append(first, first + bytes);
+        }
+
+
+        template <typename T>
+            void encodeItems(Bytes&, const T*, size_t);
+
+
+        template <typename T>
+            void encodeItems(Bytes& out, const T* items, size_t count,
+                    BitwiseCoding){
+                appendBytes(out, items, count * sizeof(T));
+            }
+
+
+        template <typename T>
+            void encodeItems(Bytes& out, const T* items, size_t count,
+                    TextCoding){
+                for (size_t i=0; i < count; ++i){
+                    std::uint64_t length = items[i].length();
+                    appendBytes(out, &length, sizeof(length));
+                    appendBytes(out, items[i].c_str(), length + 1);
+                }
+            }
+
+
+        template <typename T>
+            void encodeItems(Bytes& out, const T* items, size_t count,
+                    ArrayCoding){
+                for (size_t i=0; i < count; ++i){
+                    std::uint64_t size = items[i].size();
+                    appendBytes(out, &size, sizeof(size));
+                    encodeItems(out, items[i].begin(), items[i].size());
+                }
+            }
+
+
+        template <typename T>
+            void encodeItems(Bytes& out, const T* items, size_t count){
+                typedef typename CodingOf<T>::type Coding;
+                encodeItems(out, items, count, Coding());
+            }
+
+
+        // Reads an encoded payload that is already in memory, every
+        // length is checked against the bytes that are left so a
+        // damaged payload can't make us read past its end
+
+        class ByteReader{
+            public:
+                ByteReader(const char* first, const char* last) noexcept:
+                    at(first), end(last){}
+
+                const char* take(size_t bytes){
+                    if (bytes > left()){
+                        throw FormatMismatch();
+                    }
+
+                    const char* taken = at;
+                    at += bytes;
+                    return taken;
+                }
+
+                size_t length(){
+                    // Every encoded object takes at least one byte
+                    std::uint64_t value;
+                    std::memcpy(&value, take(sizeof(value)), sizeof(value));
+
+                    if (value > left()){
+                        throw FormatMismatch();
+                    }
+
+                    return static_cast<size_t>(value);
+                }
+
+                size_t left() const noexcept{
+                    return static_cast<size_t>(end - at);
+                }
+
+            private:
+                const char* at;
+                const char* end;
+        };
+
+
+        template <typename T>
+            void decodeItems(ByteReader&, T*, size_t);
+
+
+        template <typename T>
+            void decodeItems(ByteReader& in, T* items, size_t count,
+                    BitwiseCoding){
+                if (count > in.left() / sizeof(T)){
+                    throw FormatMismatch();
+                }
+
+                std::memcpy(static_cast<void*>(items),
+                        in.take(count * sizeof(T)), count * sizeof(T));
+            }
+
+
+        template <typename T>
+            void decodeItems(ByteReader& in, T* items, size_t count,
+                    TextCoding){
+                for (size_t i=0; i < count; ++i){
+                    size_t length = in.length();
+                    const char* text = in.take(length + 1);
+
+                    if (text[length] != '\0'){
+                        throw FormatMismatch();
+                    }
+
+                    items[i] = T(text, length);
+                }
+            }
+
+
+        template <typename T>
+            void decodeItems(ByteReader& in, T* items, size_t count,
+                    ArrayCoding){
+                for (size_t i=0; i < count; ++i){
+                    size_t size = in.length();
+                    items[i].resize(size);
+                    decodeItems(in, items[i].begin(), size);
+                }
+            }
+
+
+        template <typename T>
+            void decodeItems(ByteReader& in, T* items, size_t count){
+                decodeItems(in, items, count, typename CodingOf<T>::type());
+            }
+
+
+        static const char STREAM_MAGIC[8] = {'Z', 'H', 'D', 'A', 'R',
+            'R', 'A', 'Y'};
+
+
+        template <typename T, typename G>
+            const void* encodePayload(const DArray<T,G>& items, Bytes&,
+                    BitwiseCoding) noexcept{
+                return items.begin();
+            }
+
+        template <typename T, typename G, typename Coding>
+            const void* encodePayload(const DArray<T,G>& items,
+                    Bytes& scratch, Coding){
+                encodeItems(scratch, items.begin(), items.size());
+                return scratch.begin();
+            }
+
+
+        template <typename T, typename G>
+            const void* encode(const DArray<T,G>& items,
+                    StreamHeader& header, Bytes& scratch){
+                typedef typename CodingOf<T>::type Coding;
+                const void* payload = encodePayload(items, scratch,
+                        Coding());
+
+                std::memcpy(header.magic, STREAM_MAGIC, 8);
+                header.unitSize = sizeof(T);
+                header.count = items.size();
+                header.bytes = std::is_same<Coding, BitwiseCoding>::value ?
+                    items.size() * sizeof(T) : scratch.size();
+                header.checksum = checksum(payload, header.bytes);
+
+                return payload;
+            }
+
+
+        template <typename T, typename G, typename ReadExactly>
+            void decodePayload(DArray<T,G>& result,
+                    const StreamHeader& header, ReadExactly readExactly,
+                    BitwiseCoding){
+                if (header.count > SIZE_MAX / sizeof(T) ||
+                        header.bytes != header.count * sizeof(T)){
+                    throw FormatMismatch();
+                }
+
+                result.resize(header.count);
+                readExactly(result.begin(), header.bytes);
+
+                if (checksum(result.begin(), header.bytes) !=
+                        header.checksum){
+                    throw FormatMismatch();
+                }
+            }
+
+
+        template <typename T, typename G, typename ReadExactly,
+                 typename Coding>
+            void decodePayload(DArray<T,G>& result,
+                    const StreamHeader& header, ReadExactly readExactly,
+                    Coding){
+                if (static_cast<size_t>(header.bytes) != header.bytes ||
+                        header.count > header.bytes){
+                    throw FormatMismatch();
+                }
+
+                Bytes payload(*result.resource());
+                payload.resize(header.bytes);
+                readExactly(payload.begin(), header.bytes);
+
+                if (checksum(payload.begin(), header.bytes) !=
+                        header.checksum){
+                    throw FormatMismatch();
+                }
+
+                ByteReader in(payload.begin(), payload.end());
+                result.resize(header.count);
+                decodeItems(in, result.begin(), header.count);
+
+                if (in.left() != 0){
+                    throw FormatMismatch();
+                }
+            }
+
+
+        template <typename T, typename G, typename ReadExactly>
+            void decode(DArray<T,G>& items, ReadExactly readExactly){
+                typedef typename CodingOf<T>::type Coding;
+                StreamHeader header;
+                readExactly(&header, sizeof(header));
+
+                if (std::memcmp(header.magic, STREAM_MAGIC, 8) != 0 ||
+                        header.unitSize != sizeof(T)){
+                    throw FormatMismatch();
+                }
+
+                // Built aside so a failure leaves the array as it was
+                DArray<T,G> result(*items.resource());
+                decodePayload(result, header, readExactly, Coding());
+                items = std::move(result);
+            }
+
+
+        inline void writeAll(int fd, struct iovec* parts, int count){
+            while (count > 0){
+                ssize_t written = ::writev(fd, parts, count);
+
+                if (written < 0){
+                    if (errno == EINTR){
+                        continue;
+                    }
+
+                    throw StreamFailure();
+                }
+
+                // Skip what the kernel took, which may end in the
+                // middle of a part
+                size_t done = static_cast<size_t>(written);
+
+                while (count > 0 && done >= parts->iov_len){
+                    done -= parts->iov_len;
+                    ++parts;
+                    --count;
+                }
+
+                if (count > 0){
+                    parts->iov_base = static_cast<char*>(parts->iov_base) +
+                        done;
+                    parts->iov_len -= done;
+                }
+            }
+        }
+
+
+        inline void readAll(int fd, void* data, size_t bytes){
+            char* at = static_cast<char*>(data);
+
+            while (bytes > 0){
+                ssize_t got = ::read(fd, at, bytes);
+
+                if (got < 0){
+                    if (errno == EINTR){
+                        continue;
+                    }
+
+                    throw StreamFailure();
+                }
+
+                if (got == 0){
+                    throw StreamFailure();
+                }
+
+                at += got;
+                bytes -= static_cast<size_t>(got);
+            }
+        }
+
+    } // namespace detail
+
+
+    template <typename T, typename G>
+        void save(const DArray<T,G>& items, std::ostream& out){
+            detail::StreamHeader header;
+            detail::Bytes scratch;
+            const void* payload = detail::encode(items, header, scratch);
+
+            out.write(reinterpret_cast<const char*>(&header),
+                    sizeof(header));
+            out.write(static_cast<const char*>(payload),
+                    static_cast<std::streamsize>(header.bytes));
+
+            if (!out){
+                throw StreamFailure();
+            }
+        }
+
+
+    template <typename T, typename G>
+        void write_to(const DArray<T,G>& items, int fd){
+            detail::StreamHeader header;
+            detail::Bytes scratch;
+            const void* payload = detail::encode(items, header, scratch);
+
+            struct iovec parts[2];
+            parts[0].iov_base = &header;
+            parts[0].iov_len = sizeof(header);
+            parts[1].iov_base = const_cast<void*>(payload);
+            parts[1].iov_len = header.bytes;
+
+            detail::writeAll(fd, parts, 2);
+        }
+
+
+    template <typename T, typename G>
+        void load(DArray<T,G>& items, std::istream& in){
+            detail::decode(items, [&in](void* data, size_t bytes){
+                    in.read(static_cast<char*>(data),
+                            static_cast<std::streamsize>(bytes));
+
+                    if (!in){
+                        throw StreamFailure();
+                    }
+                });
+        }
+
+
+    template <typename T, typename G>
+        void read_from(DArray<T,G>& items, int fd){
+            detail::decode(items, [fd](void* data, size_t bytes){
+                    detail::readAll(fd, data, bytes);
+                });
+        }
+
+} // namespace zh
+
+#endif /* ifndef SERIALIZE */
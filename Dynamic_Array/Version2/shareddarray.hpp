@@ -0,0 +1,532 @@
+/*
+ * Filename:      shareddarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:50 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SHAREDDARRAY
+#define SHAREDDARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <new>
+using std::bad_alloc;
+#include <utility>
+#include <atomic>
+#include <type_traits>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, typename GrowthPolicy = DefaultGrowth>
+        class SharedDArray{
+
+            /*  // Summary of available services
+             *
+             *  A handle to a DArray<T, GrowthPolicy> that is shared
+             *  by all its copies (copy-on-write). Copying a handle
+             *  only increments an atomic reference count, the
+             *  objects are copied the first time a handle that is
+             *  not the only one modifies them.
+             *
+             *  Reading never copies, so the read services are const
+             *  and every modification goes through one of the
+             *  non-const services below.
+             *
+             *  SharedDArray() noexcept;
+             *
+             *  explicit SharedDArray(size_t);
+             *
+             *  SharedDArray(size_t, const T&);
+             *
+             *  explicit SharedDArray(DArray<T,GrowthPolicy>);
+             *
+             *  ~SharedDArray() noexcept;
+             *
+             *  SharedDArray(const SharedDArray&) noexcept;
+             *
+             *  SharedDArray(SharedDArray&&) noexcept;
+             *
+             *  SharedDArray& operator=(const SharedDArray&) noexcept;
+             *
+             *  SharedDArray& operator=(SharedDArray&&) noexcept;
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  const T& at(size_t) const;
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  const DArray<T,GrowthPolicy>& read() const;
+             *
+             *  DArray<T,GrowthPolicy>& write();
+             *
+             *  void set(size_t, const T&);
+             *
+             *  void append(const T&);
+             *
+             *  void append(T&&);
+             *
+             *  void remove_last();
+             *
+             *  void resize(size_t, const T& = T());
+             *
+             *  void clear();
+             *
+             *  size_t useCount() const;
+             *
+             *  bool isUnique() const;
+             */
+
+            static_assert(!std::is_same<T, bool>::value, "DArray<bool> "
+                    "holds bits and has no begin() to share, use "
+                    "SharedDArray<unsigned char>");
+
+            public:
+                typedef const T* const_iterator;
+
+                const_iterator begin() const{ return block->items.begin();};
+                const_iterator end() const{ return block->items.end();};
+
+                SharedDArray() noexcept;
+                /*
+                 *  Description: Create an empty array, all empty
+                 *               handles share one array so this
+                 *               never allocates
+                 *
+                 *  Exception: None
+                 */
+
+
+                explicit SharedDArray(size_t);
+
+                SharedDArray(size_t, const T&);
+                /*
+                 *  Description: Create a new array that is not shared
+                 *               yet, with the given number of copies
+                 *               of the value
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 */
+
+
+                explicit SharedDArray(DArray<T,GrowthPolicy>);
+                /*
+                 *  Description: Take over the objects of the given
+                 *               array, pass it with std::move() to
+                 *               avoid copying them
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 */
+
+
+                ~SharedDArray() noexcept;
+                /*
+                 *  Description: Release our reference, the last
+                 *               handle destroys the objects
+                 */
+
+
+                SharedDArray(const SharedDArray&) noexcept;
+
+                SharedDArray& operator=(const SharedDArray&) noexcept;
+                /*
+                 *  Description: Share the objects of the given handle
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: Best & Worst case: O(1), no object is
+                 *          copied
+                 */
+
+
+                SharedDArray(SharedDArray&&) noexcept;
+
+                SharedDArray& operator=(SharedDArray&&) noexcept;
+                /*
+                 *  Description: Take over the reference of the given
+                 *               handle, which is left empty
+                 *
+                 *  Exception: None
+                 */
+
+
+                const T& operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    if (index >= size()){
+                        detail::indexFailure(index, size(),
+                                "SharedDArray::operator[]");
+                    }
+#endif
+                    return block->items.begin()[index];
+                }
+
+                const T& at(size_t) const;
+                /*
+                 *  Description: Read access, same as DArray, at()
+                 *               throws InvalidIndexException() for
+                 *               an index out of range
+                 */
+
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+
+                const DArray<T,GrowthPolicy>& read() const noexcept;
+                /*
+                 *  Description: Returns the shared array for read
+                 *               only use, e.g. with zh::simd or
+                 *               zh::par algorithms
+                 *
+                 *  Exception: None
+                 */
+
+
+                DArray<T,GrowthPolicy>& write();
+                /*
+                 *  Description: Returns an array only this handle
+                 *               refers to, copying the objects first
+                 *               if they are shared
+                 *
+                 *  Post-condition: 1) isUnique() is true until this
+                 *                     handle is copied again
+                 *                  2) The returned reference stays
+                 *                     valid until the handle is
+                 *                     assigned or destroyed
+                 *
+                 *  Exception: 1) OutOfMemory() if the copy can't be
+                 *                made, the handle still shares the
+                 *                old array
+                 *             2) An exception of the copy constructor
+                 *                of <T> is passed on the same way
+                 *
+                 *  Remark: Best case: O(1), when the handle is the
+                 *          only one. Worst case: O(n)
+                 */
+
+
+                void set(size_t, const T&);
+
+                void append(const T&);
+
+                void append(T&&);
+
+                void remove_last();
+
+                void resize(size_t, const T& = T());
+
+                void clear();
+                /*
+                 *  Description: Same as the DArray services of the
+                 *               same name (set() assigns at an index
+                 *               checked like at()), done on write()
+                 */
+
+
+                size_t useCount() const noexcept;
+                /*
+                 *  Description: Returns the number of handles sharing
+                 *               our array, only a hint while other
+                 *               threads copy or release handles
+                 */
+
+
+                bool isUnique() const noexcept;
+                /*
+                 *  Description: Returns true if no other handle
+                 *               shares our array
+                 */
+
+
+            private:
+
+                struct Block{
+                    explicit Block(DArray<T,GrowthPolicy>&& input):
+                        references(1), items(std::move(input)){}
+
+                    std::atomic<size_t> references;
+                    DArray<T,GrowthPolicy> items;
+                };
+
+                Block* block;
+
+
+                static Block* makeBlock(DArray<T,GrowthPolicy>&&);
+                /*
+                 *  Description: Allocate a block with a reference
+                 *               count of one holding the given array
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 */
+
+
+                static Block* emptyBlock() noexcept;
+                /*
+                 *  Description: Returns the block shared by all empty
+                 *               handles with one more reference. It
+                 *               keeps a reference of its own so it is
+                 *               never destroyed, and write() always
+                 *               copies out of it
+                 *
+                 *  Remark: Made on first use, the program terminates
+                 *          if a few bytes can't be allocated then
+                 */
+
+
+                static void release(Block*) noexcept;
+                /*
+                 *  Description: Drop one reference of the block and
+                 *               destroy it if it was the last one
+                 */
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray() noexcept:
+            block(emptyBlock()){}
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray(size_t inputSize):
+            block(makeBlock(DArray<T,G>(inputSize))){}
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray(size_t inputSize, const T& value):
+            block(makeBlock(DArray<T,G>(inputSize, value))){}
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray(DArray<T,G> input):
+            block(makeBlock(std::move(input))){}
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::~SharedDArray() noexcept{
+            release(block);
+        }
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray(const SharedDArray<T,G>& copy)
+        noexcept: block(copy.block){
+            // A new reference is made from an existing one, no
+            // ordering with other memory is needed
+            block->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>& SharedDArray<T,G>::operator=(
+                const SharedDArray<T,G>& rhs) noexcept{
+            if (block != rhs.block){
+                rhs.block->references.fetch_add(1,
+                        std::memory_order_relaxed);
+                release(block);
+                block = rhs.block;
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>::SharedDArray(SharedDArray<T,G>&& other) noexcept:
+            block(other.block){
+                other.block = emptyBlock();
+            }
+
+
+    template <typename T, typename G>
+        SharedDArray<T,G>& SharedDArray<T,G>::operator=(
+                SharedDArray<T,G>&& rhs) noexcept{
+            if (this != &rhs){
+                std::swap(block, rhs.block);
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, typename G>
+        const T& SharedDArray<T,G>::at(size_t index) const{
+            return block->items.at(index);
+        }
+
+
+    template <typename T, typename G>
+        inline size_t SharedDArray<T,G>::size() const noexcept{
+            return block->items.size();
+        }
+
+
+    template <typename T, typename G>
+        inline bool SharedDArray<T,G>::isEmpty() const noexcept{
+            return block->items.isEmpty();
+        }
+
+
+    template <typename T, typename G>
+        inline const DArray<T,G>& SharedDArray<T,G>::read() const noexcept{
+            return block->items;
+        }
+
+
+    template <typename T, typename G>
+        DArray<T,G>& SharedDArray<T,G>::write(){
+            // acquire pairs with the release of the other handles,
+            // so their reads of the objects are done before we
+            // start writing to them
+            if (block->references.load(std::memory_order_acquire) != 1){
+                Block* own = makeBlock(DArray<T,G>(block->items));
+                release(block);
+                block = own;
+            }
+
+            return block->items;
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::set(size_t index, const T& value){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            write()[index] = value;
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::append(const T& value){
+            write().append(value);
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::append(T&& value){
+            write().append(std::move(value));
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::remove_last(){
+            if (isEmpty()){
+                throw ArrayEmpty();
+            }
+
+            write().remove_last();
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::resize(size_t inputSize, const T& value){
+            write().resize(inputSize, value);
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::clear(){
+            if (isUnique()){
+                block->items.clear();
+            }else{
+                // Nothing to copy, share the empty array instead
+                Block* empty = emptyBlock();
+                release(block);
+                block = empty;
+            }
+        }
+
+
+    template <typename T, typename G>
+        inline size_t SharedDArray<T,G>::useCount() const noexcept{
+            return block->references.load(std::memory_order_relaxed);
+        }
+
+
+    template <typename T, typename G>
+        inline bool SharedDArray<T,G>::isUnique() const noexcept{
+            return block->references.load(std::memory_order_acquire) == 1;
+        }
+
+
+    template <typename T, typename G>
+        typename SharedDArray<T,G>::Block*
+        SharedDArray<T,G>::makeBlock(DArray<T,G>&& input){
+            try{
+                return new Block(std::move(input));
+            }catch (bad_alloc){
+                throw OutOfMemory();
+            }
+        }
+
+
+    template <typename T, typename G>
+        typename SharedDArray<T,G>::Block*
+        SharedDArray<T,G>::emptyBlock() noexcept{
+            static Block* empty = [](){
+                Block* made = new Block(DArray<T,G>());
+                made->items.shrink_to_fit();
+                return made;
+            }();
+
+            empty->references.fetch_add(1, std::memory_order_relaxed);
+            return empty;
+        }
+
+
+    template <typename T, typename G>
+        void SharedDArray<T,G>::release(Block* input) noexcept{
+            // The last handle must see every write of the others
+            // before it destroys the objects
+            if (input->references.fetch_sub(1,
+                        std::memory_order_acq_rel) == 1){
+                delete input;
+            }
+        }
+
+} // namespace zh
+
+#endif /* ifndef SHAREDDARRAY */
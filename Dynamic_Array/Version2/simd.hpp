@@ -0,0 +1,804 @@
+/*
+ * Filename:      simd.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (09:10 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SIMD
+#define SIMD
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <type_traits>
+
+
+// SSE2 is part of x86-64, AVX2 is selected at run time. The AVX2
+// kernels need GCC's target pragma unless the whole program is
+// already built for AVX2 (-mavx2, -march=native, ...)
+
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__SSE2__)
+#define ZH_SIMD_SSE2 1
+#endif
+#if defined(__AVX2__) || (defined(__GNUC__) && !defined(__clang__))
+#define ZH_SIMD_AVX2 1
+#endif
+#endif
+
+#if defined(ZH_SIMD_SSE2) || defined(ZH_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+
+namespace zh{
+
+    namespace simd{
+
+
+        //============================================||
+        //					              ||
+        // 		       Prototype 	              ||
+        //					              ||
+        //============================================||
+
+        /*  // Summary of available services
+         *
+         *  Algorithms over contiguous ranges such as
+         *  [DArray<T>::begin(), DArray<T>::end()). int, float and
+         *  double use SSE2 or AVX2 depending on what the processor
+         *  supports, any other arithmetic type uses a plain loop.
+         *
+         *  Isa detectIsa();
+         *  Isa activeIsa();
+         *  void setIsa(Isa);
+         *
+         *  T sum(const T*, const T*);
+         *  T min(const T*, const T*);
+         *  T max(const T*, const T*);
+         *  T dot(const T*, const T*, const T*);
+         *  size_t count(const T*, const T*, const T&);
+         *  const T* find(const T*, const T*, const T&);
+         *  void fill(T*, T*, const T&);
+         *  void transform(const T*, const T*, const T*, T*, Op);
+         *  void transform(const T*, const T*, T*, UnaryOp);
+         *
+         *  Op: Plus, Minus, Multiplies, Minimum, Maximum run with
+         *  SIMD, any other binary function object runs one object
+         *  at a time
+         *
+         *  Remark: sum() and dot() of float and double add the
+         *  objects in a different order than a plain loop, so the
+         *  result may differ in the last bits
+         */
+
+
+        enum Isa { SCALAR = 0, SSE2 = 1, AVX2 = 2 };
+
+        Isa detectIsa() noexcept;
+        /*
+         *  Description: Returns the best instruction set supported
+         *               by both the processor and this build
+         */
+
+
+        Isa activeIsa() noexcept;
+        /*
+         *  Description: Returns the instruction set the algorithms
+         *               currently use, detectIsa() unless changed
+         *               with setIsa()
+         */
+
+
+        void setIsa(Isa) noexcept;
+        /*
+         *  Description: Select the instruction set the algorithms
+         *               use, it is lowered to detectIsa() if the
+         *               processor does not support it. Meant for
+         *               testing and benchmarking
+         */
+
+
+        template <typename T>
+            T sum(const T*, const T*);
+        /*
+         *  Description: Returns the sum of the objects in the range,
+         *               T() for an empty range
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T>
+            T min(const T*, const T*);
+
+        template <typename T>
+            T max(const T*, const T*);
+        /*
+         *  Description: Returns the smallest (largest) object in the
+         *               range
+         *
+         *  Pre-condition: 1) Float objects are not NaN, the vector
+         *                    min and max don't order NaN like the
+         *                    scalar loop and the result would depend
+         *                    on where it is in the range
+         *
+         *  Exception: 1) ArrayEmpty() if the range is empty
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T>
+            T dot(const T*, const T*, const T*);
+        /*
+         *  Description: Returns the sum of the products of the
+         *               objects of [first1, last1) and the objects
+         *               of the same length range starting at first2
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T>
+            size_t count(const T*, const T*, const T&);
+        /*
+         *  Description: Returns how many objects of the range are
+         *               equal to the given value
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T>
+            const T* find(const T*, const T*, const T&);
+        /*
+         *  Description: Returns the first object of the range equal
+         *               to the given value, or last if there is none
+         *
+         *  Remark: Worst case: O(n). Best case: O(1)
+         */
+
+
+        template <typename T>
+            void fill(T*, T*, const T&);
+        /*
+         *  Description: Assign the given value to every object of
+         *               the range
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T, typename Op>
+            void transform(const T*, const T*, const T*, T*, Op);
+        /*
+         *  Description: out[i] = op(first1[i], first2[i]) for every
+         *               object of [first1, last1)
+         *
+         *  Pre-condition: 1) The output range is either the same as
+         *                    one of the inputs or does not overlap
+         *                    them
+         *
+         *  Remark: Best & Worst case: O(n)
+         */
+
+
+        template <typename T, typename UnaryOp>
+            void transform(const T*, const T*, T*, UnaryOp);
+        /*
+         *  Description: out[i] = op(first[i]) for every object of
+         *               [first, last), written as a plain loop the
+         *               compiler can vectorize
+         */
+
+
+        struct Plus{
+            template <typename T>
+                T operator()(const T& a, const T& b) const{ return a + b;}
+        };
+
+        struct Minus{
+            template <typename T>
+                T operator()(const T& a, const T& b) const{ return a - b;}
+        };
+
+        struct Multiplies{
+            template <typename T>
+                T operator()(const T& a, const T& b) const{ return a * b;}
+        };
+
+        struct Minimum{
+            template <typename T>
+                T operator()(const T& a, const T& b) const{
+                    return (b < a) ? b : a;}
+        };
+
+        struct Maximum{
+            template <typename T>
+                T operator()(const T& a, const T& b) const{
+                    return (a < b) ? b : a;}
+        };
+
+    } // namespace simd
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        using simd::Plus;
+        using simd::Minus;
+        using simd::Multiplies;
+        using simd::Minimum;
+        using simd::Maximum;
+
+
+        template <typename T>
+            struct SimdSupported: std::integral_constant<bool,
+            std::is_same<T, int>::value || std::is_same<T, float>::value ||
+                std::is_same<T, double>::value>{};
+
+
+        template <typename Op>
+            struct SimdOperation: std::integral_constant<bool,
+            std::is_same<Op, Plus>::value ||
+                std::is_same<Op, Minus>::value ||
+                std::is_same<Op, Multiplies>::value ||
+                std::is_same<Op, Minimum>::value ||
+                std::is_same<Op, Maximum>::value>{};
+
+
+        namespace simd_scalar{
+
+            template <typename T>
+                T sum(const T* data, size_t count){
+                    T result = T();
+                    for (size_t i=0; i < count; ++i){
+                        result += data[i];
+                    }
+                    return result;
+                }
+
+            template <typename T, bool MAX>
+                T extreme(const T* data, size_t count){
+                    T result = data[0];
+                    for (size_t i=1; i < count; ++i){
+                        if ((MAX) ? (result < data[i]) : (data[i] < result)){
+                            result = data[i];
+                        }
+                    }
+                    return result;
+                }
+
+            template <typename T>
+                T dot(const T* lhs, const T* rhs, size_t count){
+                    T result = T();
+                    for (size_t i=0; i < count; ++i){
+                        result += lhs[i] * rhs[i];
+                    }
+                    return result;
+                }
+
+            template <typename T>
+                size_t count(const T* data, size_t length, T value){
+                    size_t result = 0;
+                    for (size_t i=0; i < length; ++i){
+                        if (data[i] == value){
+                            ++result;
+                        }
+                    }
+                    return result;
+                }
+
+            template <typename T>
+                size_t find(const T* data, size_t length, T value){
+                    for (size_t i=0; i < length; ++i){
+                        if (data[i] == value){
+                            return i;
+                        }
+                    }
+                    return length;
+                }
+
+            template <typename T>
+                void fill(T* data, size_t length, T value){
+                    for (size_t i=0; i < length; ++i){
+                        data[i] = value;
+                    }
+                }
+
+            template <typename T, typename Op>
+                void transform(const T* lhs, const T* rhs, T* out,
+                        size_t length, Op op){
+                    for (size_t i=0; i < length; ++i){
+                        out[i] = op(lhs[i], rhs[i]);
+                    }
+                }
+
+        } // namespace simd_scalar
+
+
+#ifdef ZH_SIMD_SSE2
+        namespace simd_sse2{
+
+            template <typename T>
+                struct V;
+
+            template <>
+                struct V<float>{
+                    typedef __m128 reg;
+                    static const size_t WIDTH = 4;
+                    static reg load(const float* p){ return _mm_loadu_ps(p);}
+                    static void store(float* p, reg a){ _mm_storeu_ps(p, a);}
+                    static reg set1(float v){ return _mm_set1_ps(v);}
+                    static reg zero(){ return _mm_setzero_ps();}
+                    static reg add(reg a, reg b){ return _mm_add_ps(a, b);}
+                    static reg sub(reg a, reg b){ return _mm_sub_ps(a, b);}
+                    static reg mul(reg a, reg b){ return _mm_mul_ps(a, b);}
+                    static reg min(reg a, reg b){ return _mm_min_ps(a, b);}
+                    static reg max(reg a, reg b){ return _mm_max_ps(a, b);}
+                    static int eqmask(reg a, reg b){
+                        return _mm_movemask_ps(_mm_cmpeq_ps(a, b));}
+                    typedef __m128i counter;
+                    static counter czero(){ return _mm_setzero_si128();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm_sub_epi32(c,
+                                _mm_castps_si128(_mm_cmpeq_ps(a, b)));}
+                    static size_t total(counter c){
+                        int lanes[4];
+                        _mm_storeu_si128(
+                                reinterpret_cast<__m128i*>(lanes), c);
+                        return size_t(lanes[0]) + lanes[1] + lanes[2] +
+                            lanes[3];}
+                };
+
+            template <>
+                struct V<double>{
+                    typedef __m128d reg;
+                    static const size_t WIDTH = 2;
+                    static reg load(const double* p){ return _mm_loadu_pd(p);}
+                    static void store(double* p, reg a){ _mm_storeu_pd(p, a);}
+                    static reg set1(double v){ return _mm_set1_pd(v);}
+                    static reg zero(){ return _mm_setzero_pd();}
+                    static reg add(reg a, reg b){ return _mm_add_pd(a, b);}
+                    static reg sub(reg a, reg b){ return _mm_sub_pd(a, b);}
+                    static reg mul(reg a, reg b){ return _mm_mul_pd(a, b);}
+                    static reg min(reg a, reg b){ return _mm_min_pd(a, b);}
+                    static reg max(reg a, reg b){ return _mm_max_pd(a, b);}
+                    static int eqmask(reg a, reg b){
+                        return _mm_movemask_pd(_mm_cmpeq_pd(a, b));}
+                    typedef __m128i counter;
+                    static counter czero(){ return _mm_setzero_si128();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm_sub_epi64(c,
+                                _mm_castpd_si128(_mm_cmpeq_pd(a, b)));}
+                    static size_t total(counter c){
+                        long long lanes[2];
+                        _mm_storeu_si128(
+                                reinterpret_cast<__m128i*>(lanes), c);
+                        return size_t(lanes[0] + lanes[1]);}
+                };
+
+            template <>
+                struct V<int>{
+                    // SSE2 has no 32 bit min, max and low multiply,
+                    // they are built from compares and shuffles
+                    typedef __m128i reg;
+                    static const size_t WIDTH = 4;
+                    static reg load(const int* p){
+                        return _mm_loadu_si128(
+                                reinterpret_cast<const __m128i*>(p));}
+                    static void store(int* p, reg a){
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);}
+                    static reg set1(int v){ return _mm_set1_epi32(v);}
+                    static reg zero(){ return _mm_setzero_si128();}
+                    static reg add(reg a, reg b){ return _mm_add_epi32(a, b);}
+                    static reg sub(reg a, reg b){ return _mm_sub_epi32(a, b);}
+                    static reg mul(reg a, reg b){
+                        reg even = _mm_mul_epu32(a, b);
+                        reg odd = _mm_mul_epu32(_mm_srli_si128(a, 4),
+                                _mm_srli_si128(b, 4));
+                        return _mm_unpacklo_epi32(
+                                _mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+                                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+                    }
+                    static reg min(reg a, reg b){
+                        reg greater = _mm_cmpgt_epi32(a, b);
+                        return _mm_or_si128(_mm_and_si128(greater, b),
+                                _mm_andnot_si128(greater, a));
+                    }
+                    static reg max(reg a, reg b){
+                        reg greater = _mm_cmpgt_epi32(a, b);
+                        return _mm_or_si128(_mm_and_si128(greater, a),
+                                _mm_andnot_si128(greater, b));
+                    }
+                    static int eqmask(reg a, reg b){
+                        return _mm_movemask_ps(
+                                _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));}
+                    typedef __m128i counter;
+                    static counter czero(){ return _mm_setzero_si128();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm_sub_epi32(c, _mm_cmpeq_epi32(a, b));}
+                    static size_t total(counter c){
+                        int lanes[4];
+                        _mm_storeu_si128(
+                                reinterpret_cast<__m128i*>(lanes), c);
+                        return size_t(lanes[0]) + lanes[1] + lanes[2] +
+                            lanes[3];}
+                };
+
+#include "simdkernels.hpp"
+
+        } // namespace simd_sse2
+#endif
+
+
+#ifdef ZH_SIMD_AVX2
+#ifndef __AVX2__
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+        namespace simd_avx2{
+
+            template <typename T>
+                struct V;
+
+            template <>
+                struct V<float>{
+                    typedef __m256 reg;
+                    static const size_t WIDTH = 8;
+                    static reg load(const float* p){
+                        return _mm256_loadu_ps(p);}
+                    static void store(float* p, reg a){
+                        _mm256_storeu_ps(p, a);}
+                    static reg set1(float v){ return _mm256_set1_ps(v);}
+                    static reg zero(){ return _mm256_setzero_ps();}
+                    static reg add(reg a, reg b){ return _mm256_add_ps(a, b);}
+                    static reg sub(reg a, reg b){ return _mm256_sub_ps(a, b);}
+                    static reg mul(reg a, reg b){ return _mm256_mul_ps(a, b);}
+                    static reg min(reg a, reg b){ return _mm256_min_ps(a, b);}
+                    static reg max(reg a, reg b){ return _mm256_max_ps(a, b);}
+                    static int eqmask(reg a, reg b){
+                        return _mm256_movemask_ps(
+                                _mm256_cmp_ps(a, b, _CMP_EQ_OQ));}
+                    typedef __m256i counter;
+                    static counter czero(){ return _mm256_setzero_si256();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm256_sub_epi32(c, _mm256_castps_si256(
+                                    _mm256_cmp_ps(a, b, _CMP_EQ_OQ)));}
+                    static size_t total(counter c){
+                        int lanes[8];
+                        _mm256_storeu_si256(
+                                reinterpret_cast<__m256i*>(lanes), c);
+                        size_t sum = 0;
+                        for (int j=0; j < 8; ++j){ sum += lanes[j];}
+                        return sum;}
+                };
+
+            template <>
+                struct V<double>{
+                    typedef __m256d reg;
+                    static const size_t WIDTH = 4;
+                    static reg load(const double* p){
+                        return _mm256_loadu_pd(p);}
+                    static void store(double* p, reg a){
+                        _mm256_storeu_pd(p, a);}
+                    static reg set1(double v){ return _mm256_set1_pd(v);}
+                    static reg zero(){ return _mm256_setzero_pd();}
+                    static reg add(reg a, reg b){ return _mm256_add_pd(a, b);}
+                    static reg sub(reg a, reg b){ return _mm256_sub_pd(a, b);}
+                    static reg mul(reg a, reg b){ return _mm256_mul_pd(a, b);}
+                    static reg min(reg a, reg b){ return _mm256_min_pd(a, b);}
+                    static reg max(reg a, reg b){ return _mm256_max_pd(a, b);}
+                    static int eqmask(reg a, reg b){
+                        return _mm256_movemask_pd(
+                                _mm256_cmp_pd(a, b, _CMP_EQ_OQ));}
+                    typedef __m256i counter;
+                    static counter czero(){ return _mm256_setzero_si256();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm256_sub_epi64(c, _mm256_castpd_si256(
+                                    _mm256_cmp_pd(a, b, _CMP_EQ_OQ)));}
+                    static size_t total(counter c){
+                        long long lanes[4];
+                        _mm256_storeu_si256(
+                                reinterpret_cast<__m256i*>(lanes), c);
+                        return size_t(lanes[0] + lanes[1] + lanes[2] +
+                                lanes[3]);}
+                };
+
+            template <>
+                struct V<int>{
+                    typedef __m256i reg;
+                    static const size_t WIDTH = 8;
+                    static reg load(const int* p){
+                        return _mm256_loadu_si256(
+                                reinterpret_cast<const __m256i*>(p));}
+                    static void store(int* p, reg a){
+                        _mm256_storeu_si256(
+                                reinterpret_cast<__m256i*>(p), a);}
+                    static reg set1(int v){ return _mm256_set1_epi32(v);}
+                    static reg zero(){ return _mm256_setzero_si256();}
+                    static reg add(reg a, reg b){
+                        return _mm256_add_epi32(a, b);}
+                    static reg sub(reg a, reg b){
+                        return _mm256_sub_epi32(a, b);}
+                    static reg mul(reg a, reg b){
+                        return _mm256_mullo_epi32(a, b);}
+                    static reg min(reg a, reg b){
+                        return _mm256_min_epi32(a, b);}
+                    static reg max(reg a, reg b){
+                        return _mm256_max_epi32(a, b);}
+                    static int eqmask(reg a, reg b){
+                        return _mm256_movemask_ps(_mm256_castsi256_ps(
+                                    _mm256_cmpeq_epi32(a, b)));}
+                    typedef __m256i counter;
+                    static counter czero(){ return _mm256_setzero_si256();}
+                    static counter eqcount(counter c, reg a, reg b){
+                        return _mm256_sub_epi32(c, _mm256_cmpeq_epi32(a, b));}
+                    static size_t total(counter c){
+                        int lanes[8];
+                        _mm256_storeu_si256(
+                                reinterpret_cast<__m256i*>(lanes), c);
+                        size_t sum = 0;
+                        for (int j=0; j < 8; ++j){ sum += lanes[j];}
+                        return sum;}
+                };
+
+#include "simdkernels.hpp"
+
+        } // namespace simd_avx2
+#ifndef __AVX2__
+#pragma GCC pop_options
+#endif
+#endif
+
+
+        inline simd::Isa& selectedIsa() noexcept{
+            static simd::Isa isa = simd::detectIsa();
+            return isa;
+        }
+
+
+        // Every algorithm picks its kernel the same way, the
+        // std::true_type overloads are only instantiated for
+        // int, float and double
+
+#ifdef ZH_SIMD_AVX2
+#define ZH_SIMD_CASE_AVX2(...) case simd::AVX2: return simd_avx2::__VA_ARGS__;
+#else
+#define ZH_SIMD_CASE_AVX2(...)
+#endif
+
+#ifdef ZH_SIMD_SSE2
+#define ZH_SIMD_CASE_SSE2(...) case simd::SSE2: return simd_sse2::__VA_ARGS__;
+#else
+#define ZH_SIMD_CASE_SSE2(...)
+#endif
+
+#define ZH_SIMD_DISPATCH(...)                           \
+        switch (selectedIsa()){                         \
+            ZH_SIMD_CASE_AVX2(__VA_ARGS__)              \
+            ZH_SIMD_CASE_SSE2(__VA_ARGS__)              \
+            default: return simd_scalar::__VA_ARGS__;   \
+        }
+
+
+        template <typename T>
+            inline T simdSum(const T* data, size_t n, std::true_type){
+                ZH_SIMD_DISPATCH(sum(data, n))
+            }
+
+        template <typename T>
+            inline T simdSum(const T* data, size_t n, std::false_type){
+                return simd_scalar::sum(data, n);
+            }
+
+        template <typename T, bool MAX>
+            inline T simdExtreme(const T* data, size_t n, std::true_type){
+                ZH_SIMD_DISPATCH(extreme<T, MAX>(data, n))
+            }
+
+        template <typename T, bool MAX>
+            inline T simdExtreme(const T* data, size_t n, std::false_type){
+                return simd_scalar::extreme<T, MAX>(data, n);
+            }
+
+        template <typename T>
+            inline T simdDot(const T* lhs, const T* rhs, size_t n,
+                    std::true_type){
+                ZH_SIMD_DISPATCH(dot(lhs, rhs, n))
+            }
+
+        template <typename T>
+            inline T simdDot(const T* lhs, const T* rhs, size_t n,
+                    std::false_type){
+                return simd_scalar::dot(lhs, rhs, n);
+            }
+
+        template <typename T>
+            inline size_t simdCount(const T* data, size_t n, T value,
+                    std::true_type){
+                ZH_SIMD_DISPATCH(count(data, n, value))
+            }
+
+        template <typename T>
+            inline size_t simdCount(const T* data, size_t n, T value,
+                    std::false_type){
+                return simd_scalar::count(data, n, value);
+            }
+
+        template <typename T>
+            inline size_t simdFind(const T* data, size_t n, T value,
+                    std::true_type){
+                ZH_SIMD_DISPATCH(find(data, n, value))
+            }
+
+        template <typename T>
+            inline size_t simdFind(const T* data, size_t n, T value,
+                    std::false_type){
+                return simd_scalar::find(data, n, value);
+            }
+
+        template <typename T>
+            inline void simdFill(T* data, size_t n, T value, std::true_type){
+                ZH_SIMD_DISPATCH(fill(data, n, value))
+            }
+
+        template <typename T>
+            inline void simdFill(T* data, size_t n, T value, std::false_type){
+                simd_scalar::fill(data, n, value);
+            }
+
+        template <typename T, typename Op>
+            inline void simdTransform(const T* lhs, const T* rhs, T* out,
+                    size_t n, Op op, std::true_type){
+                ZH_SIMD_DISPATCH(transform(lhs, rhs, out, n, op))
+            }
+
+        template <typename T, typename Op>
+            inline void simdTransform(const T* lhs, const T* rhs, T* out,
+                    size_t n, Op op, std::false_type){
+                simd_scalar::transform(lhs, rhs, out, n, op);
+            }
+
+#undef ZH_SIMD_DISPATCH
+#undef ZH_SIMD_CASE_SSE2
+#undef ZH_SIMD_CASE_AVX2
+
+    } // namespace detail
+
+
+    namespace simd{
+
+        inline Isa detectIsa() noexcept{
+#ifdef ZH_SIMD_AVX2
+            if (__builtin_cpu_supports("avx2")){
+                return AVX2;
+            }
+#endif
+#ifdef ZH_SIMD_SSE2
+            return SSE2;
+#else
+            return SCALAR;
+#endif
+        }
+
+
+        inline Isa activeIsa() noexcept{
+            return detail::selectedIsa();
+        }
+
+
+        inline void setIsa(Isa isa) noexcept{
+            Isa best = detectIsa();
+            detail::selectedIsa() = (isa > best) ? best : isa;
+        }
+
+
+        template <typename T>
+            T sum(const T* first, const T* last){
+                return detail::simdSum(first, last - first,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            T min(const T* first, const T* last){
+                if (first == last){
+                    throw ArrayEmpty();
+                }
+
+                return detail::simdExtreme<T, false>(first, last - first,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            T max(const T* first, const T* last){
+                if (first == last){
+                    throw ArrayEmpty();
+                }
+
+                return detail::simdExtreme<T, true>(first, last - first,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            T dot(const T* first1, const T* last1, const T* first2){
+                return detail::simdDot(first1, first2, last1 - first1,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            size_t count(const T* first, const T* last, const T& value){
+                return detail::simdCount(first, last - first, value,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            const T* find(const T* first, const T* last, const T& value){
+                return first + detail::simdFind(first, last - first, value,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T>
+            void fill(T* first, T* last, const T& value){
+                detail::simdFill(first, last - first, value,
+                        detail::SimdSupported<T>());
+            }
+
+
+        template <typename T, typename Op>
+            void transform(const T* first1, const T* last1,
+                    const T* first2, T* out, Op op){
+                detail::simdTransform(first1, first2, out, last1 - first1, op,
+                        std::integral_constant<bool,
+                        detail::SimdSupported<T>::value &&
+                        detail::SimdOperation<Op>::value>());
+            }
+
+
+        template <typename T, typename UnaryOp>
+            void transform(const T* first, const T* last, T* out,
+                    UnaryOp op){
+                size_t length = last - first;
+
+                for (size_t i=0; i < length; ++i){
+                    out[i] = op(first[i]);
+                }
+            }
+
+    } // namespace simd
+
+} // namespace zh
+
+#endif /* ifndef SIMD */
@@ -0,0 +1,246 @@
+/*
+ * Filename:      simdkernels.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sat Oct 17, 2026 (08:50 PM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+// Kernels of simd.hpp, written once against a register traits
+// class V<T> and compiled once per instruction set.
+//
+// This file has no include guard on purpose: simd.hpp includes it
+// inside namespace detail::simd_sse2 and again inside
+// detail::simd_avx2 (with the avx2 target enabled), each namespace
+// providing its own V<T>. Do not include it anywhere else.
+
+
+template <typename T>
+    T sum(const T* data, size_t count){
+        typedef V<T> W;
+        typename W::reg first = W::zero();
+        typename W::reg second = W::zero();
+        size_t i = 0;
+
+        // Two accumulators hide the latency of the additions
+        for (; i + 2 * W::WIDTH <= count; i += 2 * W::WIDTH){
+            first = W::add(first, W::load(data + i));
+            second = W::add(second, W::load(data + i + W::WIDTH));
+        }
+
+        for (; i + W::WIDTH <= count; i += W::WIDTH){
+            first = W::add(first, W::load(data + i));
+        }
+
+        T lanes[W::WIDTH];
+        W::store(lanes, W::add(first, second));
+        T result = T();
+
+        for (size_t j=0; j < W::WIDTH; ++j){
+            result += lanes[j];
+        }
+
+        for (; i < count; ++i){
+            result += data[i];
+        }
+
+        return result;
+    }
+
+
+template <typename T, bool MAX>
+    T extreme(const T* data, size_t count){
+        // Pre-condition: count > 0
+        typedef V<T> W;
+        T result = data[0];
+        size_t i = 0;
+
+        if (count >= W::WIDTH){
+            typename W::reg best = W::load(data);
+
+            for (i = W::WIDTH; i + W::WIDTH <= count; i += W::WIDTH){
+                best = (MAX) ? W::max(best, W::load(data + i)) :
+                    W::min(best, W::load(data + i));
+            }
+
+            T lanes[W::WIDTH];
+            W::store(lanes, best);
+            result = lanes[0];
+
+            for (size_t j=1; j < W::WIDTH; ++j){
+                if ((MAX) ? (result < lanes[j]) : (lanes[j] < result)){
+                    result = lanes[j];
+                }
+            }
+        }
+
+        for (; i < count; ++i){
+            if ((MAX) ? (result < data[i]) : (data[i] < result)){
+                result = data[i];
+            }
+        }
+
+        return result;
+    }
+
+
+template <typename T>
+    T dot(const T* lhs, const T* rhs, size_t count){
+        typedef V<T> W;
+        typename W::reg first = W::zero();
+        typename W::reg second = W::zero();
+        size_t i = 0;
+
+        for (; i + 2 * W::WIDTH <= count; i += 2 * W::WIDTH){
+            first = W::add(first,
+                    W::mul(W::load(lhs + i), W::load(rhs + i)));
+            second = W::add(second, W::mul(W::load(lhs + i + W::WIDTH),
+                        W::load(rhs + i + W::WIDTH)));
+        }
+
+        for (; i + W::WIDTH <= count; i += W::WIDTH){
+            first = W::add(first,
+                    W::mul(W::load(lhs + i), W::load(rhs + i)));
+        }
+
+        T lanes[W::WIDTH];
+        W::store(lanes, W::add(first, second));
+        T result = T();
+
+        for (size_t j=0; j < W::WIDTH; ++j){
+            result += lanes[j];
+        }
+
+        for (; i < count; ++i){
+            result += lhs[i] * rhs[i];
+        }
+
+        return result;
+    }
+
+
+template <typename T>
+    size_t count(const T* data, size_t length, T value){
+        // The lanes of the counter subtract the all ones compare
+        // result, they are emptied into result before a 32 bit
+        // lane could overflow
+        typedef V<T> W;
+        const size_t BLOCK = size_t(1) << 30;
+        typename W::reg wanted = W::set1(value);
+        size_t result = 0;
+        size_t i = 0;
+
+        while (i + W::WIDTH <= length){
+            typename W::counter lanes = W::czero();
+            size_t stop = (length - i > BLOCK) ? i + BLOCK : length;
+
+            for (; i + W::WIDTH <= stop; i += W::WIDTH){
+                lanes = W::eqcount(lanes, W::load(data + i), wanted);
+            }
+
+            result += W::total(lanes);
+        }
+
+        for (; i < length; ++i){
+            if (data[i] == value){
+                ++result;
+            }
+        }
+
+        return result;
+    }
+
+
+template <typename T>
+    size_t find(const T* data, size_t length, T value){
+        // Returns length when the value is not found
+        typedef V<T> W;
+        typename W::reg wanted = W::set1(value);
+        size_t i = 0;
+
+        for (; i + W::WIDTH <= length; i += W::WIDTH){
+            int mask = W::eqmask(W::load(data + i), wanted);
+
+            if (mask != 0){
+                return i + __builtin_ctz(mask);
+            }
+        }
+
+        for (; i < length; ++i){
+            if (data[i] == value){
+                return i;
+            }
+        }
+
+        return length;
+    }
+
+
+template <typename T>
+    void fill(T* data, size_t length, T value){
+        typedef V<T> W;
+        typename W::reg item = W::set1(value);
+        size_t i = 0;
+
+        for (; i + W::WIDTH <= length; i += W::WIDTH){
+            W::store(data + i, item);
+        }
+
+        for (; i < length; ++i){
+            data[i] = value;
+        }
+    }
+
+
+template <typename T>
+    inline typename V<T>::reg apply(Plus, typename V<T>::reg a,
+            typename V<T>::reg b){ return V<T>::add(a, b);}
+
+template <typename T>
+    inline typename V<T>::reg apply(Minus, typename V<T>::reg a,
+            typename V<T>::reg b){ return V<T>::sub(a, b);}
+
+template <typename T>
+    inline typename V<T>::reg apply(Multiplies, typename V<T>::reg a,
+            typename V<T>::reg b){ return V<T>::mul(a, b);}
+
+template <typename T>
+    inline typename V<T>::reg apply(Minimum, typename V<T>::reg a,
+            typename V<T>::reg b){ return V<T>::min(a, b);}
+
+template <typename T>
+    inline typename V<T>::reg apply(Maximum, typename V<T>::reg a,
+            typename V<T>::reg b){ return V<T>::max(a, b);}
+
+
+template <typename T, typename Op>
+    void transform(const T* lhs, const T* rhs, T* out, size_t length,
+            Op op){
+        typedef V<T> W;
+        size_t i = 0;
+
+        for (; i + W::WIDTH <= length; i += W::WIDTH){
+            W::store(out + i, apply<T>(op, W::load(lhs + i),
+                        W::load(rhs + i)));
+        }
+
+        for (; i < length; ++i){
+            out[i] = op(lhs[i], rhs[i]);
+        }
+    }
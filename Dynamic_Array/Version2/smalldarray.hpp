@@ -0,0 +1,768 @@
+/*
+ * Filename:      smalldarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (06:35 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SMALLDARRAY
+#define SMALLDARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <new>
+using std::bad_alloc;
+#include <utility>
+#include <type_traits>
+#include <iterator>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t N = 8,
+             typename GrowthPolicy = DefaultGrowth>
+        class SmallDArray{
+
+            /*  // Summary of available services
+             *
+             *  Same services as DArray<T, GrowthPolicy>, the first N
+             *  objects are stored inside the object itself and the
+             *  heap is only used once the array grows beyond N.
+             *  Creating an empty SmallDArray never allocates.
+             *
+             *  SmallDArray() noexcept;
+             *
+             *  explicit SmallDArray(MemoryResource&) noexcept;
+             *
+             *  explicit SmallDArray(size_t);
+             *
+             *  SmallDArray(size_t, const T&);
+             *
+             *  ~SmallDArray() noexcept;
+             *
+             *  SmallDArray(const SmallDArray&);
+             *
+             *  SmallDArray(SmallDArray&&);
+             *
+             *  SmallDArray& operator=(const SmallDArray&);
+             *
+             *  SmallDArray& operator=(SmallDArray&&);
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  T& operator[](size_t);
+             *
+             *  const T& at(size_t) const;
+             *
+             *  T& at(size_t);
+             *
+             *  void resize(size_t, const T& = T());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  void clear();
+             *
+             *  void add(const T&, size_t);
+             *
+             *  void add(T&&, size_t);
+             *
+             *  void append(const T&);
+             *
+             *  void append(T&&);
+             *
+             *  template <typename... Args>
+             *      void emplace_back(Args&&...);
+             *
+             *  template <typename... Args>
+             *      void emplace(size_t, Args&&...);
+             *
+             *  template <typename InputIt>
+             *      void append(InputIt, InputIt);
+             *
+             *  void append_n(size_t, const T&);
+             *
+             *  void remove(size_t);
+             *
+             *  void remove_last();
+             *
+             *  size_t capacity() const;
+             *
+             *  void reserve(size_t);
+             *
+             *  bool isInline() const;
+             */
+
+            static_assert(N > 0, "SmallDArray needs room for at least "
+                    "one object inline");
+
+            public:
+                typedef T* iterator;
+                typedef const T* const_iterator;
+
+                iterator begin(){ return buffer;};
+                iterator end(){return buffer + logicalSize;};
+                const_iterator begin() const{ return buffer;};
+                const_iterator end() const{return buffer + logicalSize;};
+
+                SmallDArray() noexcept;
+                /*
+                 *  Description: Create an empty array using the
+                 *               inline storage
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: Best & Worst case: O(1), no memory is
+                 *          allocated
+                 */
+
+
+                explicit SmallDArray(MemoryResource&) noexcept;
+                /*
+                 *  Description: Create an empty array whose heap,
+                 *               once it spills beyond N objects, is
+                 *               obtained from the given resource
+                 *
+                 *  Pre-condition: 1) The resource outlives the array
+                 *
+                 *  Exception: None
+                 */
+
+
+                explicit SmallDArray(size_t);
+                /*
+                 *  Description: Create an array of the specified
+                 *               size with default constructed objects
+                 *
+                 *  Exception: 1) OutOfMemory() if the size is larger
+                 *                than N and the heap cannot be
+                 *                allocated
+                 *             2) An exception of a constructor of <T>
+                 *                is passed on, after the objects
+                 *                already built and the heap are
+                 *                given back
+                 *
+                 *  Remark: Best & Worst case: O(n)
+                 */
+
+
+                SmallDArray(size_t, const T&);
+                /*
+                 *  Description: Create an array of the specified
+                 *               size with copies of the given value
+                 *
+                 *  Exception: 1) OutOfMemory() if the size is larger
+                 *                than N and the heap cannot be
+                 *                allocated
+                 *             2) An exception of a constructor of <T>
+                 *                is passed on, after the objects
+                 *                already built and the heap are
+                 *                given back
+                 *
+                 *  Remark: Best & Worst case: O(n)
+                 */
+
+
+                ~SmallDArray() noexcept;
+
+
+                SmallDArray(const SmallDArray&);
+                /*
+                 *  Description: Copy every object of the input array,
+                 *               the copy uses the default memory
+                 *               resource
+                 *
+                 *  Exception: 1) OutOfMemory() if a heap is needed
+                 *                and cannot be allocated
+                 *             2) An exception of a copy constructor
+                 *                is passed on, nothing is leaked
+                 */
+
+
+                SmallDArray(SmallDArray&&)
+                    noexcept(std::is_nothrow_move_constructible<T>::value);
+                /*
+                 *  Description: Take over the heap of the input array
+                 *               if it has spilled, otherwise move its
+                 *               objects one by one into our inline
+                 *               storage
+                 *
+                 *  Post-condition: 1) The input array is empty and
+                 *                     back on its inline storage
+                 *
+                 *  Remark: Worst case: O(N), when the objects are
+                 *          inline. Best case: O(1)
+                 */
+
+
+                SmallDArray& operator=(const SmallDArray&);
+
+
+                SmallDArray& operator=(SmallDArray&&);
+
+
+                const T& operator[](size_t) const;
+
+                T& operator[](size_t);
+                /*
+                 *  Exception: None, checked only when
+                 *             ZH_CHECKED_ACCESS is 1 (see dynarray.hpp)
+                 */
+
+
+                const T& at(size_t) const;
+
+                T& at(size_t);
+                /*
+                 *  Exception: 1) Throws InvalidIndexException() if the
+                 *                input index is equal to or greater
+                 *                than the size of the array
+                 */
+
+
+                void resize(size_t, const T& = T());
+
+                size_t size() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+                void clear();
+                /*
+                 *  Post-condition: 1) All objects are destroyed, the
+                 *                     heap (if any) is kept for reuse
+                 */
+
+
+                void add(const T&, size_t);
+
+                void add(T&&, size_t);
+
+                void append(const T&);
+
+                void append(T&&);
+
+                template <typename... Args>
+                    void emplace_back(Args&&...);
+
+                template <typename... Args>
+                    void emplace(size_t, Args&&...);
+
+                template <typename InputIt,
+                         typename = typename std::enable_if<
+                             !std::is_integral<InputIt>::value>::type>
+                    void append(InputIt, InputIt);
+
+                void append_n(size_t, const T&);
+                /*
+                 *  Exception: 1) OutOfMemory() if a larger heap is
+                 *                needed and can't be allocated
+                 *             2) An exception of a copy constructor
+                 *                is passed on
+                 *             In both cases no object is appended
+                 */
+
+
+                void remove(size_t);
+
+                void remove_last();
+                /*
+                 *  Exception: 1) ArrayEmpty() exception is thrown
+                 *                is size of array is zero
+                 */
+
+
+                size_t capacity() const noexcept;
+                /*
+                 *  Description: Returns N while the objects are
+                 *               inline, the size of the heap otherwise
+                 */
+
+
+                void reserve(size_t);
+                /*
+                 *  Description: Make room for at least the specified
+                 *               number of objects, moving the objects
+                 *               to the heap if it is more than N
+                 *
+                 *  Exception: 1) OutOfMemory() if the heap cannot be
+                 *                allocated, the array is unchanged
+                 */
+
+
+                bool isInline() const noexcept;
+                /*
+                 *  Description: Returns true while the objects are
+                 *               stored inside the object itself
+                 */
+
+
+            private:
+                T* buffer;
+                size_t physicalSize;
+                size_t logicalSize;
+                MemoryResource* heapResource;
+                typename std::aligned_storage<sizeof(T),
+                         alignof(T)>::type inlineStorage[N];
+
+                T* inlineBuffer() noexcept;
+
+                void releaseHeap() noexcept;
+                /*
+                 *  Description: Give the heap back to our resource
+                 *               and point buffer at the inline
+                 *               storage again
+                 *
+                 *  Pre-condition: 1) The array is empty
+                 */
+
+
+                void takeOver(SmallDArray&) noexcept(
+                        std::is_nothrow_move_constructible<T>::value);
+                /*
+                 *  Description: Take the objects of the input array,
+                 *               stealing its heap if it has one
+                 *
+                 *  Pre-condition: 1) Our array is empty and inline
+                 */
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray() noexcept:
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(newDeleteResource()){}
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray(MemoryResource& source) noexcept:
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(&source){}
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray(size_t inputSize):
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(newDeleteResource()){
+                // The destructor won't run if a constructor of <T>
+                // throws, the objects built so far and a heap we
+                // spilled to are given back here
+                try{
+                    append_n(inputSize, T());
+                }catch (...){
+                    clear();
+                    releaseHeap();
+                    throw;
+                }
+            }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray(size_t inputSize, const T& input):
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(newDeleteResource()){
+                // The destructor won't run if a constructor of <T>
+                // throws, the objects built so far and a heap we
+                // spilled to are given back here
+                try{
+                    append_n(inputSize, input);
+                }catch (...){
+                    clear();
+                    releaseHeap();
+                    throw;
+                }
+            }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::~SmallDArray() noexcept{
+            clear();
+            releaseHeap();
+        }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray(const SmallDArray& copy):
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(newDeleteResource()){
+                // The destructor won't run if a constructor of <T>
+                // throws, the objects built so far and a heap we
+                // spilled to are given back here
+                try{
+                    append(copy.begin(), copy.end());
+                }catch (...){
+                    clear();
+                    releaseHeap();
+                    throw;
+                }
+            }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>::SmallDArray(SmallDArray&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value):
+            buffer(inlineBuffer()), physicalSize(N), logicalSize(0),
+            heapResource(other.heapResource){
+                takeOver(other);
+            }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>& SmallDArray<T,N,G>::operator=(
+                const SmallDArray& rhs){
+            if (this != &rhs){
+                clear();
+                append(rhs.begin(), rhs.end());
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        SmallDArray<T,N,G>& SmallDArray<T,N,G>::operator=(
+                SmallDArray&& rhs){
+            if (this != &rhs){
+                clear();
+                releaseHeap();
+                heapResource = rhs.heapResource;
+                takeOver(rhs);
+            }
+
+            return *this;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline const T& SmallDArray<T,N,G>::operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize,
+                        "SmallDArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline T& SmallDArray<T,N,G>::operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+            if (index >= logicalSize){
+                detail::indexFailure(index, logicalSize,
+                        "SmallDArray::operator[]");
+            }
+#endif
+            return *(buffer+index);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        const T& SmallDArray<T,N,G>::at(size_t index) const{
+            if (index < logicalSize){
+                return *(buffer+index);
+            }else{
+                throw InvalidIndexException();
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        T& SmallDArray<T,N,G>::at(size_t index){
+            if (index < logicalSize){
+                return *(buffer+index);
+            }else{
+                throw InvalidIndexException();
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::resize(size_t inputSize, const T& value){
+            if (inputSize > logicalSize){
+                append_n(inputSize - logicalSize, value);
+            }else{
+                while (logicalSize != inputSize){
+                    remove_last();
+                }
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline size_t SmallDArray<T,N,G>::size() const noexcept{
+            return logicalSize;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline bool SmallDArray<T,N,G>::isEmpty() const noexcept{
+            return logicalSize == 0;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::clear(){
+            for (size_t i=0; i < logicalSize; ++i){
+                (&buffer[i])->~T();
+            }
+
+            logicalSize = 0;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::add(const T& value, size_t index){
+            emplace(index, value);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::add(T&& value, size_t index){
+            emplace(index, std::move(value));
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::append(const T& value){
+            emplace_back(value);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::append(T&& value){
+            emplace_back(std::move(value));
+        }
+
+
+    template <typename T, size_t N, typename G>
+        template <typename... Args>
+        void SmallDArray<T,N,G>::emplace_back(Args&&... args){
+            if (logicalSize < physicalSize){
+                try{
+                    new (buffer + logicalSize) T(std::forward<Args>(args)...);
+                }catch (bad_alloc){
+                    throw OutOfMemory();
+                }
+            }else{
+                // The arguments may refer to one of our own
+                // objects, build the new object before moving
+                T item(std::forward<Args>(args)...);
+                reserve(G::grow(physicalSize, logicalSize+1));
+
+                try{
+                    new (buffer + logicalSize) T(std::move(item));
+                }catch (bad_alloc){
+                    throw OutOfMemory();
+                }
+            }
+
+            ++logicalSize;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        template <typename... Args>
+        void SmallDArray<T,N,G>::emplace(size_t index, Args&&... args){
+            if (index > size()){
+                throw InvalidIndexException();
+            }else if (index == size()){
+                emplace_back(std::forward<Args>(args)...);
+            }else{
+                T item(std::forward<Args>(args)...);
+
+                emplace_back(std::move(*(buffer+logicalSize-1)));
+
+                for (size_t i=logicalSize-2; i>index; i--){
+                    *(buffer+i) = std::move(*(buffer+i-1));
+                }
+
+                *(buffer+index) = std::move(item);
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        template <typename InputIt, typename>
+        void SmallDArray<T,N,G>::append(InputIt first, InputIt last){
+            for (; first != last; ++first){
+                emplace_back(*first);
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::append_n(size_t count, const T& value){
+            if (count == 0){
+                return;
+            }
+
+            size_t start = logicalSize;
+
+            try{
+                if (logicalSize + count > physicalSize){
+                    T item(value);
+                    reserve(G::grow(physicalSize, logicalSize + count));
+
+                    for (size_t i=0; i < count; ++i){
+                        emplace_back(item);
+                    }
+                }else{
+                    for (size_t i=0; i < count; ++i){
+                        emplace_back(value);
+                    }
+                }
+            }catch (...){
+                // Like DArray::append_n(), nothing is appended
+                while (logicalSize > start){
+                    --logicalSize;
+                    (&buffer[logicalSize])->~T();
+                }
+
+                throw;
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::remove(size_t index){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }else{
+
+                for (size_t i=index; i < size()-1; i++){
+                    *(buffer+i) = std::move(*(buffer+i+1));
+                }
+
+                remove_last();
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::remove_last(){
+            if (isEmpty()){
+                throw ArrayEmpty();
+            }else {
+                --logicalSize;
+                (&buffer[logicalSize])->~T();
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline size_t SmallDArray<T,N,G>::capacity() const noexcept{
+            return physicalSize;
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::reserve(size_t inputSize){
+            if (inputSize > physicalSize){
+                T* newBuffer = nullptr;
+
+                try{
+                    newBuffer = static_cast<T*>(heapResource->allocate(
+                                inputSize * sizeof(T), alignof(T)));
+                }catch (bad_alloc){
+                    throw OutOfMemory();
+                }
+
+                try{
+                    detail::relocate(buffer, newBuffer, logicalSize);
+                }catch (...){
+                    heapResource->deallocate(newBuffer,
+                            inputSize * sizeof(T), alignof(T));
+                    throw;
+                }
+
+                if (!isInline()){
+                    heapResource->deallocate(buffer,
+                            physicalSize * sizeof(T), alignof(T));
+                }
+
+                buffer = newBuffer;
+                physicalSize = inputSize;
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline bool SmallDArray<T,N,G>::isInline() const noexcept{
+            return buffer == reinterpret_cast<const T*>(inlineStorage);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        inline T* SmallDArray<T,N,G>::inlineBuffer() noexcept{
+            return reinterpret_cast<T*>(inlineStorage);
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::releaseHeap() noexcept{
+            if (!isInline()){
+                heapResource->deallocate(buffer,
+                        physicalSize * sizeof(T), alignof(T));
+                buffer = inlineBuffer();
+                physicalSize = N;
+            }
+        }
+
+
+    template <typename T, size_t N, typename G>
+        void SmallDArray<T,N,G>::takeOver(SmallDArray& other) noexcept(
+                std::is_nothrow_move_constructible<T>::value){
+            if (other.isInline()){
+                // relocate() destroys the objects it moved from
+                detail::relocate(other.buffer, buffer, other.logicalSize);
+                logicalSize = other.logicalSize;
+                other.logicalSize = 0;
+            }else{
+                buffer = other.buffer;
+                physicalSize = other.physicalSize;
+                logicalSize = other.logicalSize;
+
+                other.buffer = other.inlineBuffer();
+                other.physicalSize = N;
+                other.logicalSize = 0;
+            }
+        }
+
+} // namespace zh
+
+#endif /* ifndef SMALLDARRAY */
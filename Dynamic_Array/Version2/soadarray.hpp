@@ -0,0 +1,546 @@
+/*
+ * Filename:      soadarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (07:05 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SOADARRAY
+#define SOADARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+
+namespace zh{
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    namespace detail{
+
+        template <typename... Fields>
+            struct AnyBool: std::false_type{};
+
+        template <typename First, typename... Rest>
+            struct AnyBool<First, Rest...>: std::integral_constant<bool,
+            std::is_same<First, bool>::value ||
+            AnyBool<Rest...>::value>{};
+
+    } // namespace detail
+
+
+
+    template <typename T>
+        class ColumnSpan{
+
+            /*  // Summary of available services
+             *
+             *  View of one column of a SoADArray: a pointer and a
+             *  length, so a column can be handed to zh::simd,
+             *  zh::par or any loop over contiguous objects.
+             *  Invalidated when the array reallocates.
+             */
+
+            public:
+                typedef T* iterator;
+
+                ColumnSpan(T* first, size_t count) noexcept:
+                    items(first), length(count){}
+
+                T* begin() const noexcept{ return items;};
+                T* end() const noexcept{ return items + length;};
+                T* data() const noexcept{ return items;};
+                size_t size() const noexcept{ return length;};
+
+                T& operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    if (index >= length){
+                        detail::indexFailure(index, length,
+                                "ColumnSpan::operator[]");
+                    }
+#endif
+                    return items[index];
+                }
+
+            private:
+                T* items;
+                size_t length;
+        };
+
+
+    template <typename... Fields>
+        class SoADArray{
+
+            /*  // Summary of available services
+             *
+             *  Array of records with the given field types, stored
+             *  as one DArray per field (structure of arrays). A loop
+             *  that reads one field only touches the memory of that
+             *  field, instead of pulling whole records through the
+             *  cache.
+             *
+             *  The columns always have the same size and are grown
+             *  together, as decided by DefaultGrowth.
+             *
+             *  SoADArray();
+             *
+             *  void append(const Fields&...);
+             *
+             *  void remove_last();
+             *
+             *  void remove(size_t);
+             *
+             *  void resize(size_t);
+             *
+             *  void clear();
+             *
+             *  void reserve(size_t);
+             *
+             *  size_t size() const;
+             *
+             *  size_t capacity() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  Row operator[](size_t);
+             *
+             *  ConstRow operator[](size_t) const;
+             *
+             *  Row at(size_t);
+             *
+             *  ConstRow at(size_t) const;
+             *
+             *  template <size_t I>
+             *      ColumnSpan<Field<I>> column();
+             *
+             *  template <size_t I>
+             *      ColumnSpan<const Field<I>> column() const;
+             */
+
+            static_assert(sizeof...(Fields) > 0,
+                    "SoADArray needs at least one field");
+            static_assert(!detail::AnyBool<Fields...>::value, "A bool "
+                    "field would be a bit packed DArray<bool> without "
+                    "column pointers, use unsigned char");
+
+            public:
+
+                template <size_t I>
+                    using Field = typename std::tuple_element<I,
+                          std::tuple<Fields...> >::type;
+
+
+                template <bool CONST>
+                    class RowProxy{
+                        // One record of the array, the fields are
+                        // reached through get<I>(). Holds the array
+                        // and the index only, so it stays valid
+                        // while the array reallocates
+                        typedef typename std::conditional<CONST,
+                                const SoADArray, SoADArray>::type Owner;
+
+                        public:
+                            RowProxy(Owner* array, size_t position)
+                                noexcept: owner(array), index(position){}
+
+                            template <size_t I>
+                                typename std::conditional<CONST,
+                                const Field<I>&, Field<I>&>::type
+                                get() const{
+                                    return std::get<I>(
+                                            owner->columns).begin()[index];
+                                }
+
+                            std::tuple<Fields...> value() const{
+                                return owner->rowValue(index,
+                                        std::index_sequence_for<Fields...>());
+                            }
+
+                            void assign(const Fields&... values) const{
+                                static_assert(!CONST, "assign() through "
+                                        "a ConstRow");
+                                owner->assignRow(index,
+                                        std::forward_as_tuple(values...),
+                                        std::index_sequence_for<Fields...>());
+                            }
+
+                        private:
+                            Owner* owner;
+                            size_t index;
+                    };
+
+                typedef RowProxy<false> Row;
+                typedef RowProxy<true> ConstRow;
+
+
+                SoADArray();
+                /*
+                 *  Description: Create an empty array
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 */
+
+
+                void append(const Fields&...);
+                /*
+                 *  Description: Append a record made of the given
+                 *               field values
+                 *
+                 *  Post-condition: 1) Every column grows by one
+                 *                     object, all columns reallocate
+                 *                     together when full
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available
+                 *             2) An exception of a copy constructor
+                 *                is passed on, the fields appended so
+                 *                far are removed again so all
+                 *                columns keep the same size
+                 *
+                 *  Remark: Best case: O(1). Worst case: O(n) when the
+                 *          columns are reallocated
+                 */
+
+
+                void remove_last();
+                /*
+                 *  Description: Remove the last record
+                 *
+                 *  Exception: 1) ArrayEmpty() if the array is empty
+                 */
+
+
+                void remove(size_t);
+                /*
+                 *  Description: Remove the record at the specified
+                 *               index, the records after it move one
+                 *               position to the left
+                 *
+                 *  Exception: 1) InvalidIndexException() if the
+                 *                index is not below size
+                 */
+
+
+                void resize(size_t);
+                /*
+                 *  Description: Change the number of records, new
+                 *               records have value initialized fields
+                 *
+                 *  Exception: 1) OutOfMemory() if insufficient
+                 *                memory is available, the columns
+                 *                grown so far are shrunk back
+                 */
+
+
+                void clear();
+
+                void reserve(size_t);
+                /*
+                 *  Description: Same as DArray, done on every column
+                 */
+
+
+                size_t size() const noexcept;
+
+                size_t capacity() const noexcept;
+
+                bool isEmpty() const noexcept;
+
+
+                Row operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+                    if (index >= size()){
+                        detail::indexFailure(index, size(),
+                                "SoADArray::operator[]");
+                    }
+#endif
+                    return Row(this, index);
+                }
+
+                ConstRow operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    if (index >= size()){
+                        detail::indexFailure(index, size(),
+                                "SoADArray::operator[]");
+                    }
+#endif
+                    return ConstRow(this, index);
+                }
+
+                Row at(size_t);
+
+                ConstRow at(size_t) const;
+                /*
+                 *  Description: Returns a proxy of the record at the
+                 *               specified index, same checks as
+                 *               DArray
+                 */
+
+
+                template <size_t I>
+                    ColumnSpan<Field<I> > column() noexcept{
+                        return ColumnSpan<Field<I> >(
+                                std::get<I>(columns).begin(), size());
+                    }
+
+                template <size_t I>
+                    ColumnSpan<const Field<I> > column() const noexcept{
+                        return ColumnSpan<const Field<I> >(
+                                std::get<I>(columns).begin(), size());
+                    }
+                /*
+                 *  Description: Returns the objects of field I of
+                 *               every record as one contiguous span
+                 *
+                 *  Exception: None
+                 *
+                 *  Remark: Best & Worst case: O(1)
+                 */
+
+
+            private:
+                std::tuple<DArray<Fields>...> columns;
+
+
+                template <size_t... I>
+                    std::tuple<Fields...> rowValue(size_t,
+                            std::index_sequence<I...>) const;
+
+                template <size_t... I>
+                    void assignRow(size_t,
+                            const std::tuple<const Fields&...>&,
+                            std::index_sequence<I...>);
+
+                void appendFields(const std::tuple<const Fields&...>&,
+                        std::integral_constant<size_t, sizeof...(Fields)>)
+                    noexcept{}
+
+                template <size_t I>
+                    void appendFields(const std::tuple<const Fields&...>&,
+                            std::integral_constant<size_t, I>);
+
+                void resizeFields(size_t, size_t,
+                        std::integral_constant<size_t, sizeof...(Fields)>)
+                    noexcept{}
+
+                template <size_t I>
+                    void resizeFields(size_t, size_t,
+                            std::integral_constant<size_t, I>);
+                /*
+                 *  Description: Apply the operation to column I and
+                 *               then to the following ones, undoing
+                 *               it on column I if a later column
+                 *               throws
+                 */
+
+
+                template <typename F, size_t... I>
+                    void forEachColumn(F, std::index_sequence<I...>);
+                /*
+                 *  Description: Call f(column) for every column
+                 */
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename... Fields>
+        SoADArray<Fields...>::SoADArray(){}
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::append(const Fields&... values){
+            if (size() == capacity()){
+                reserve(DefaultGrowth::grow(capacity(), size() + 1));
+            }
+
+            appendFields(std::forward_as_tuple(values...),
+                    std::integral_constant<size_t, 0>());
+        }
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::remove_last(){
+            if (isEmpty()){
+                throw ArrayEmpty();
+            }
+
+            forEachColumn([](auto& column){ column.remove_last();},
+                    std::index_sequence_for<Fields...>());
+        }
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::remove(size_t index){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            forEachColumn([index](auto& column){
+                    column.erase(index, index + 1);},
+                    std::index_sequence_for<Fields...>());
+        }
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::resize(size_t inputSize){
+            resizeFields(inputSize, size(),
+                    std::integral_constant<size_t, 0>());
+        }
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::clear(){
+            forEachColumn([](auto& column){ column.clear();},
+                    std::index_sequence_for<Fields...>());
+        }
+
+
+    template <typename... Fields>
+        void SoADArray<Fields...>::reserve(size_t inputSize){
+            // A column that fails leaves the others larger, the
+            // columns only need the same size, not the same capacity
+            forEachColumn([inputSize](auto& column){
+                    column.reserve(inputSize);},
+                    std::index_sequence_for<Fields...>());
+        }
+
+
+    template <typename... Fields>
+        inline size_t SoADArray<Fields...>::size() const noexcept{
+            return std::get<0>(columns).size();
+        }
+
+
+    template <typename... Fields>
+        inline size_t SoADArray<Fields...>::capacity() const noexcept{
+            return std::get<0>(columns).capacity();
+        }
+
+
+    template <typename... Fields>
+        inline bool SoADArray<Fields...>::isEmpty() const noexcept{
+            return size() == 0;
+        }
+
+
+    template <typename... Fields>
+        typename SoADArray<Fields...>::Row
+        SoADArray<Fields...>::at(size_t index){
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            return Row(this, index);
+        }
+
+
+    template <typename... Fields>
+        typename SoADArray<Fields...>::ConstRow
+        SoADArray<Fields...>::at(size_t index) const{
+            if (index >= size()){
+                throw InvalidIndexException();
+            }
+
+            return ConstRow(this, index);
+        }
+
+
+    template <typename... Fields>
+        template <size_t... I>
+        std::tuple<Fields...> SoADArray<Fields...>::rowValue(size_t index,
+                std::index_sequence<I...>) const{
+            return std::tuple<Fields...>(
+                    std::get<I>(columns).begin()[index]...);
+        }
+
+
+    template <typename... Fields>
+        template <size_t... I>
+        void SoADArray<Fields...>::assignRow(size_t index,
+                const std::tuple<const Fields&...>& values,
+                std::index_sequence<I...>){
+            typedef int Expand[];
+            (void) Expand{0, (std::get<I>(columns).begin()[index] =
+                    std::get<I>(values), 0)...};
+        }
+
+
+    template <typename... Fields>
+        template <size_t I>
+        void SoADArray<Fields...>::appendFields(
+                const std::tuple<const Fields&...>& values,
+                std::integral_constant<size_t, I>){
+            std::get<I>(columns).append(std::get<I>(values));
+
+            try{
+                appendFields(values, std::integral_constant<size_t, I+1>());
+            }catch (...){
+                std::get<I>(columns).remove_last();
+                throw;
+            }
+        }
+
+
+    template <typename... Fields>
+        template <size_t I>
+        void SoADArray<Fields...>::resizeFields(size_t inputSize,
+                size_t oldSize, std::integral_constant<size_t, I>){
+            std::get<I>(columns).resize(inputSize, Field<I>());
+
+            try{
+                resizeFields(inputSize, oldSize,
+                        std::integral_constant<size_t, I+1>());
+            }catch (...){
+                // Only growing can throw, shrinking back can't
+                std::get<I>(columns).resize(oldSize, Field<I>());
+                throw;
+            }
+        }
+
+
+    template <typename... Fields>
+        template <typename F, size_t... I>
+        void SoADArray<Fields...>::forEachColumn(F f,
+                std::index_sequence<I...>){
+            typedef int Expand[];
+            (void) Expand{0, (f(std::get<I>(columns)), 0)...};
+        }
+
+} // namespace zh
+
+#endif /* ifndef SOADARRAY */
@@ -0,0 +1,461 @@
+/*
+ * Filename:      staticdarray.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (03:10 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef STATICDARRAY
+#define STATICDARRAY
+#include "dynarray.hpp"
+#include <cstddef>
+using std::size_t;
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+
+
+namespace zh{
+
+
+    class ArrayFull{};
+
+
+    //============================================||
+    //					          ||
+    // 		       Prototype 	          ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t N>
+        class StaticDArray{
+
+            /*  // Summary of available services
+             *
+             *  Array of at most N objects with the services of DArray,
+             *  stored inside the object itself: it never allocates.
+             *  Every service is constexpr, so for a literal type <T>
+             *  (int, double, plain structs) a table can be built,
+             *  changed and read at compile time:
+             *
+             *      constexpr StaticDArray<int, 16> primes(){
+             *          StaticDArray<int, 16> table;
+             *          ...
+             *          table.append(next);
+             *          ...
+             *          return table;
+             *      }
+             *
+             *      constexpr StaticDArray<int, 16> PRIMES = primes();
+             *
+             *  All N slots always hold an object, slots past size()
+             *  hold default constructed ones, so <T> has to be
+             *  default constructible. Removing an object assigns T()
+             *  to its slot, releasing what it owned.
+             *
+             *  StaticDArray();
+             *
+             *  explicit StaticDArray(size_t);
+             *
+             *  StaticDArray(size_t, const T&);
+             *
+             *  StaticDArray(std::initializer_list<T>);
+             *
+             *  const T& operator[](size_t) const;
+             *
+             *  T& operator[](size_t);
+             *
+             *  const T& at(size_t) const;
+             *
+             *  T& at(size_t);
+             *
+             *  void resize(size_t, const T& = T());
+             *
+             *  size_t size() const;
+             *
+             *  bool isEmpty() const;
+             *
+             *  bool isFull() const;
+             *
+             *  static size_t capacity();
+             *
+             *  void clear();
+             *
+             *  void add(const T&, size_t);
+             *
+             *  void add(T&&, size_t);
+             *
+             *  void append(const T&);
+             *
+             *  void append(T&&);
+             *
+             *  template <typename... Args>
+             *      void emplace_back(Args&&...);
+             *
+             *  void remove(size_t);
+             *
+             *  void remove_last();
+             */
+
+            static_assert(N > 0, "StaticDArray needs room for at least "
+                    "one object");
+            static_assert(std::is_default_constructible<T>::value,
+                    "StaticDArray needs a default constructible type");
+
+            public:
+                typedef T* iterator;
+                typedef const T* const_iterator;
+
+                constexpr iterator begin(){ return items;};
+                constexpr iterator end(){return items + logicalSize;};
+                constexpr const_iterator begin() const{ return items;};
+                constexpr const_iterator end() const{
+                    return items + logicalSize;
+                };
+
+                constexpr StaticDArray();
+                /*
+                 *  Description: Create an empty array
+                 *
+                 *  Exception: None, unless the default constructor of
+                 *             <T> throws
+                 *
+                 *  Remark: Best & Worst case: O(N), every slot is
+                 *          default constructed. No memory is allocated
+                 */
+
+
+                constexpr explicit StaticDArray(size_t);
+
+                constexpr StaticDArray(size_t, const T&);
+                /*
+                 *  Description: Create an array of the specified size
+                 *               with default constructed objects or
+                 *               copies of the given value
+                 *
+                 *  Exception: 1) ArrayFull() if the size is larger
+                 *                than N
+                 */
+
+
+                constexpr StaticDArray(std::initializer_list<T>);
+                /*
+                 *  Description: Create an array holding copies of the
+                 *               listed objects
+                 *
+                 *  Exception: 1) ArrayFull() if more than N objects
+                 *                are listed
+                 */
+
+
+                constexpr const T& operator[](size_t index) const{
+#if ZH_CHECKED_ACCESS
+                    if (index >= logicalSize){
+                        detail::indexFailure(index, logicalSize,
+                                "StaticDArray::operator[]");
+                    }
+#endif
+                    return items[index];
+                }
+
+                constexpr T& operator[](size_t index){
+#if ZH_CHECKED_ACCESS
+                    if (index >= logicalSize){
+                        detail::indexFailure(index, logicalSize,
+                                "StaticDArray::operator[]");
+                    }
+#endif
+                    return items[index];
+                }
+                /*
+                 *  Exception: None, checked only when
+                 *             ZH_CHECKED_ACCESS is 1 (see dynarray.hpp)
+                 */
+
+
+                constexpr const T& at(size_t) const;
+
+                constexpr T& at(size_t);
+                /*
+                 *  Exception: 1) Throws InvalidIndexException() if the
+                 *                input index is equal to or greater
+                 *                than the size of the array
+                 */
+
+
+                constexpr void resize(size_t, const T& = T());
+                /*
+                 *  Description: Grow the array with copies of the
+                 *               given value or shrink it to the
+                 *               specified size
+                 *
+                 *  Exception: 1) ArrayFull() if the size is larger
+                 *                than N, the array is unchanged
+                 */
+
+
+                constexpr size_t size() const noexcept;
+
+                constexpr bool isEmpty() const noexcept;
+
+                constexpr bool isFull() const noexcept;
+
+                static constexpr size_t capacity() noexcept{
+                    return N;
+                }
+
+
+                constexpr void clear();
+
+
+                constexpr void add(const T&, size_t);
+
+                constexpr void add(T&&, size_t);
+                /*
+                 *  Description: Insert an object at the specified
+                 *               index, shifting the objects from the
+                 *               index onwards one place to the right
+                 *
+                 *  Exception: 1) InvalidIndexException() if the index
+                 *                is greater than the size
+                 *             2) ArrayFull() if the array holds N
+                 *                objects already
+                 *
+                 *  Remark: Worst case: O(n), Best case: O(1) at the
+                 *          end of the array
+                 */
+
+
+                constexpr void append(const T&);
+
+                constexpr void append(T&&);
+
+                template <typename... Args>
+                    constexpr void emplace_back(Args&&...);
+                /*
+                 *  Exception: 1) ArrayFull() if the array holds N
+                 *                objects already
+                 *
+                 *  Remark: Best & Worst case: O(1)
+                 */
+
+
+                constexpr void remove(size_t);
+                /*
+                 *  Exception: 1) InvalidIndexException() if the index
+                 *                is not below the size
+                 */
+
+
+                constexpr void remove_last();
+                /*
+                 *  Exception: 1) ArrayEmpty() exception is thrown
+                 *                is size of array is zero
+                 */
+
+
+            private:
+                T items[N];
+                size_t logicalSize;
+        };
+
+
+
+
+    //============================================||
+    //						  ||
+    // 	               Definition 		  ||
+    //					          ||
+    //============================================||
+
+
+    template <typename T, size_t N>
+        constexpr StaticDArray<T,N>::StaticDArray(): items(),
+        logicalSize(0){}
+
+
+    template <typename T, size_t N>
+        constexpr StaticDArray<T,N>::StaticDArray(size_t inputSize):
+            items(), logicalSize(0){
+                resize(inputSize, T());
+            }
+
+
+    template <typename T, size_t N>
+        constexpr StaticDArray<T,N>::StaticDArray(size_t inputSize,
+                const T& input): items(), logicalSize(0){
+            resize(inputSize, input);
+        }
+
+
+    template <typename T, size_t N>
+        constexpr StaticDArray<T,N>::StaticDArray(
+                std::initializer_list<T> input): items(), logicalSize(0){
+            if (input.size() > N){
+                throw ArrayFull();
+            }
+
+            for (const T* i = input.begin(); i != input.end(); ++i){
+                items[logicalSize++] = *i;
+            }
+        }
+
+
+    template <typename T, size_t N>
+        constexpr const T& StaticDArray<T,N>::at(size_t index) const{
+            if (index >= logicalSize){
+                throw InvalidIndexException();
+            }
+
+            return items[index];
+        }
+
+
+    template <typename T, size_t N>
+        constexpr T& StaticDArray<T,N>::at(size_t index){
+            if (index >= logicalSize){
+                throw InvalidIndexException();
+            }
+
+            return items[index];
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::resize(size_t inputSize,
+                const T& value){
+            if (inputSize > N){
+                throw ArrayFull();
+            }
+
+            while (logicalSize < inputSize){
+                items[logicalSize++] = value;
+            }
+
+            while (logicalSize > inputSize){
+                items[--logicalSize] = T();
+            }
+        }
+
+
+    template <typename T, size_t N>
+        constexpr size_t StaticDArray<T,N>::size() const noexcept{
+            return logicalSize;
+        }
+
+
+    template <typename T, size_t N>
+        constexpr bool StaticDArray<T,N>::isEmpty() const noexcept{
+            return logicalSize == 0;
+        }
+
+
+    template <typename T, size_t N>
+        constexpr bool StaticDArray<T,N>::isFull() const noexcept{
+            return logicalSize == N;
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::clear(){
+            resize(0);
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::add(const T& value, size_t index){
+            T copy(value);
+            add(std::move(copy), index);
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::add(T&& value, size_t index){
+            if (index > logicalSize){
+                throw InvalidIndexException();
+            }
+
+            if (logicalSize == N){
+                throw ArrayFull();
+            }
+
+            for (size_t i = logicalSize; i > index; --i){
+                items[i] = std::move(items[i-1]);
+            }
+
+            items[index] = std::move(value);
+            ++logicalSize;
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::append(const T& value){
+            if (logicalSize == N){
+                throw ArrayFull();
+            }
+
+            items[logicalSize++] = value;
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::append(T&& value){
+            if (logicalSize == N){
+                throw ArrayFull();
+            }
+
+            items[logicalSize++] = std::move(value);
+        }
+
+
+    template <typename T, size_t N>
+        template <typename... Args>
+        constexpr void StaticDArray<T,N>::emplace_back(Args&&... args){
+            append(T(std::forward<Args>(args)...));
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::remove(size_t index){
+            if (index >= logicalSize){
+                throw InvalidIndexException();
+            }
+
+            for (size_t i = index + 1; i < logicalSize; ++i){
+                items[i-1] = std::move(items[i]);
+            }
+
+            items[--logicalSize] = T();
+        }
+
+
+    template <typename T, size_t N>
+        constexpr void StaticDArray<T,N>::remove_last(){
+            if (logicalSize == 0){
+                throw ArrayEmpty();
+            }
+
+            items[--logicalSize] = T();
+        }
+
+} // namespace zh
+
+#endif /* ifndef STATICDARRAY */
@@ -2,7 +2,7 @@
  * Filename:      list.hpp
  * Version:       2.0
  * Author:        zah
- * Last Modified: Thu Nov 17, 2016 (01:31 PM)
+ * Last Modified: Sun Oct 18, 2026 (02:40 AM)
  *
  * Copyright © 2016 zah
  *
@@ -31,6 +31,8 @@ using std::ptrdiff_t;
 #include <iterator>
 using std::bidirectional_iterator_tag;
 
+#include "instrument.hpp"
+
 
 namespace zh{
 
@@ -936,6 +938,7 @@ namespace zh{
         List<T>::List(){
             counter = 0;
             header = new LNode;
+            ZH_COUNT(allocated(this, sizeof(LNode), 0));
             header->next = header;
             header->prev = header;
         }
@@ -945,6 +948,7 @@ namespace zh{
         List<t>::~List(){
             clear();
             delete header;
+            ZH_COUNT(released(this, sizeof(LNode)));
         }
 
 
@@ -952,6 +956,7 @@ namespace zh{
         List<T>::List(const List& inputList){
             counter = 0;
             header = new LNode;
+            ZH_COUNT(allocated(this, sizeof(LNode), 0));
             header->next = header;
             header->prev = header;
             *this = inputList;
@@ -967,6 +972,8 @@ namespace zh{
                 for (; itr != rhs.const_end(); ++itr){
                     push_back(*itr);
                 }
+
+                ZH_COUNT(copied(this, rhs.size()));
             }
             return *this;
         }
@@ -1063,6 +1070,7 @@ namespace zh{
             }
 
             List<T>::LNode* LNodeOnHeap = new LNode(inputObj);
+            ZH_COUNT(allocated(this, sizeof(LNode), counter + 1));
 
             LNodeOnHeap->next = inputIter.ptr;
             LNodeOnHeap->prev = inputIter.ptr->prev;
@@ -1099,6 +1107,7 @@ namespace zh{
 
             ++inputIter;
             delete currentNode;
+            ZH_COUNT(released(this, sizeof(LNode)));
             --counter;
 
             return inputIter;
@@ -1152,6 +1161,7 @@ namespace zh{
             SQITR current = from;
             counter = 0;
             header = new LNode;
+            ZH_COUNT(allocated(this, sizeof(LNode), 0));
             header->next = header;
             header->prev = header;
 
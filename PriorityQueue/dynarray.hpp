@@ -2,7 +2,7 @@
  * Filename:      darray.hpp
  * Version:       2.0
  * Author:        zah
- * Last Modified: Fri Nov 25, 2016 (09:23 PM)
+ * Last Modified: Sun Oct 18, 2026 (08:45 AM)
  *
  * Copyright © 2016 zah
  *
@@ -28,6 +28,7 @@
 using std::size_t;
 #include <new>
 using std::bad_alloc;
+#include "instrument.hpp"
 
 
 namespace zh{
@@ -904,6 +905,8 @@ namespace zh{
                 myHeap = new unsigned char[SIZE_DEFAULT*unitSize]; 
                 buffer = reinterpret_cast<T*>(myHeap);
                 physicalSize = SIZE_DEFAULT;
+                ZH_COUNT(allocated(this, physicalSize * unitSize,
+                            physicalSize));
             }catch (bad_alloc){
                 throw OutOfMemory();
             }
@@ -922,6 +925,8 @@ namespace zh{
                 try{
                     myHeap = new unsigned char[physicalSize * unitSize]; 
                     buffer = reinterpret_cast<T*>(myHeap);
+                    ZH_COUNT(allocated(this, physicalSize * unitSize,
+                                physicalSize));
                 }catch (bad_alloc){
                     physicalSize = logicalSize = 0;
                     throw OutOfMemory();
@@ -949,6 +954,8 @@ namespace zh{
                 try{
                     myHeap = new unsigned char[physicalSize*unitSize];
                     buffer = reinterpret_cast<T*>(myHeap);
+                    ZH_COUNT(allocated(this, physicalSize * unitSize,
+                                physicalSize));
                 }catch (bad_alloc){
                     physicalSize = logicalSize = 0;
                     throw OutOfMemory();   
@@ -989,6 +996,8 @@ namespace zh{
                 for (size_t i=0; i < logicalSize; ++i){
                     *(buffer+i) = *(rhs.buffer+i);
                 }
+
+                ZH_COUNT(copied(this, logicalSize));
             }
 
             return *this;
@@ -1176,6 +1185,10 @@ namespace zh{
 
     template <typename T>
         void DArray<T>::cleanHeap(){
+            if (myHeap != nullptr){
+                ZH_COUNT(released(this, physicalSize * unitSize));
+            }
+
             delete [] myHeap;
             buffer = nullptr;
             myHeap = nullptr;
@@ -1199,6 +1212,7 @@ namespace zh{
                 try{
                     myHeap = new unsigned char[newSize * unitSize];
                     buffer = reinterpret_cast<T*>(myHeap);
+                    ZH_COUNT(allocated(this, newSize * unitSize, newSize));
                 } catch (bad_alloc){
                     myHeap = oldHeap;
                     throw OutOfMemory();
@@ -1217,6 +1231,7 @@ namespace zh{
                         (&buffer[i])->~T();
                     }
                     delete [] myHeap;
+                    ZH_COUNT(released(this, newSize * unitSize));
                     myHeap = oldHeap;
                     buffer = oldBuffer;
                     throw;
@@ -1228,6 +1243,13 @@ namespace zh{
                 }
 
                 delete [] oldHeap;
+
+                // A copy constructed array reserves without a buffer
+                if (oldHeap != nullptr){
+                    ZH_COUNT(released(this, physicalSize * unitSize));
+                    ZH_COUNT(reallocated(this));
+                    ZH_COUNT(copied(this, logicalSize));
+                }
                 physicalSize = newSize;
 
             }
@@ -1244,6 +1266,8 @@ namespace zh{
         try{
             myHeap = new unsigned char[physicalSize * unitSize]; 
             buffer = reinterpret_cast<T*>(myHeap);
+            ZH_COUNT(allocated(this, physicalSize * unitSize,
+                        physicalSize));
         }catch (bad_alloc){
             physicalSize = logicalSize = 0;
             throw OutOfMemory();
@@ -1263,6 +1287,8 @@ namespace zh{
         for (size_t i=0; i < logicalSize; ++i){
             *(buffer+i) = static_cast<T>(input[i]);
         }
+
+        ZH_COUNT(copied(this, logicalSize));
     }
 
 } // namespace zh
@@ -2,7 +2,7 @@
  * Filename:      pqueue.hpp
  * Version:       1.0
  * Author:        zah
- * Last Modified: Thu Dec 01, 2016 (06:40 PM)
+ * Last Modified: Sun Oct 18, 2026 (02:40 AM)
  *
  * Copyright © 2016 zah
  *
@@ -81,6 +81,9 @@ namespace zh{
                     PQueue(SQITER begin, SQITER end);
 
             private:
+                // With ZH_INSTRUMENT the memory of the heap is
+                // counted by DArray<T>, objects copied while
+                // sifting are counted by PQueue
                 DArray<T> bheap;
                 F callback;
         };
@@ -112,6 +115,7 @@ namespace zh{
 
             while (hole > 0 && callback(item, bheap[parent])){
                 bheap[hole] = bheap[parent];
+                ZH_COUNT(copied(this, 1));
                 hole = parent;
                 parent = (hole-1)/2;
             }
@@ -146,6 +150,7 @@ namespace zh{
 
                 if (callback(bheap[child], tmp)){
                     bheap[hole] = bheap[child];
+                    ZH_COUNT(copied(this, 1));
                     hole = child;
                     child = hole * 2 + 1;
                 } else {
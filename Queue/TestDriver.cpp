@@ -1,7 +1,7 @@
 /*
  * Filename:      TestDriver.cpp
  * Author:        zah
- * Last Modified: 26/09/2016 
+ * Last Modified: 18/10/2026 
  *
  * Copyright © 2016 zah
  *
@@ -155,12 +155,27 @@ int main(void)
     CTest1(ulongVar.size() == 3, "Implicit conversion test of ulongVar with size()");
 
 
+    zh::instrument::reset<String>();
+    {
+        String word("counted");
+        String wordCopy = word;
+        wordCopy += word;
+    }
+    zh::instrument::Snapshot counts = zh::instrument::snapshot<String>();
+#if ZH_INSTRUMENT
+    CTest1(counts.allocations == counts.deallocations && counts.allocations >= 2 &&
+            counts.copies >= 7, "String counters with instrumentation");
+#else
+    CTest1(counts.allocations == 0, "String counters compiled out");
+#endif
+
+
     cout << "[+] Total tests passed: (" << nPass << "/" << (nPass+nFail) << ")" << endl;
     return 0;
 }
 /*
  * Queue/ $ g++ *.cpp -o bin/TestDriver
  * Queue/ $ ./bin/TestDriver
- * [+] Total tests passed: (38/38)
+ * [+] Total tests passed: (39/39)
  *
  **/
@@ -0,0 +1,390 @@
+/*
+ * Filename:      instrument.hpp
+ * Version:       1.0
+ * Author:        zah
+ * Last Modified: Sun Oct 18, 2026 (02:40 AM)
+ *
+ * Copyright © 2016 zah
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef INSTRUMENT
+#define INSTRUMENT
+#include <cstddef>
+using std::size_t;
+#include <atomic>
+#include <iostream>
+#include <type_traits>
+#include <typeinfo>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+
+// Allocation and copy counters of the zh containers
+//
+// 0: the hooks in the containers expand to nothing, no counter
+//    exists and nothing is paid. The default
+// 1: every container type counts its allocations, the blocks it
+//    gives back, the bytes of both, its reallocations, the
+//    objects it copies and moves and its peak capacity
+//
+// Has to be the same in every file of a program, build with
+// -DZH_INSTRUMENT=1 to turn it on
+
+#ifndef ZH_INSTRUMENT
+#define ZH_INSTRUMENT 0
+#endif
+
+#if ZH_INSTRUMENT
+#define ZH_COUNT(hook) ::zh::instrument::hook
+#else
+#define ZH_COUNT(hook) ((void) 0)
+#endif
+
+
+namespace zh{
+
+    namespace instrument{
+
+
+
+        //============================================||
+        //					              ||
+        // 		       Prototype 	              ||
+        //					              ||
+        //============================================||
+
+
+        /*  // Summary of available services
+         *
+         *  Counters are kept per container type, a DArray<int> and
+         *  a DArray<double> are counted apart. All counters are
+         *  atomic, containers may be used from any thread.
+         *
+         *  struct Snapshot;
+         *
+         *  template <typename Container>
+         *      Snapshot snapshot() noexcept;
+         *
+         *  template <typename Container>
+         *      void reset() noexcept;
+         *
+         *  void dump(std::ostream& = std::cerr);
+         *
+         *  // Hooks, only called through ZH_COUNT() by containers
+         *
+         *  template <typename C>
+         *      void allocated(const C*, size_t bytes, size_t capacity) noexcept;
+         *
+         *  template <typename C>
+         *      void released(const C*, size_t bytes) noexcept;
+         *
+         *  template <typename C>
+         *      void reallocated(const C*) noexcept;
+         *
+         *  template <typename T, typename C>
+         *      void relocated(const C*, size_t count) noexcept;
+         *
+         *  template <typename C>
+         *      void copied(const C*, size_t count) noexcept;
+         */
+
+
+        struct Snapshot{
+            size_t allocations;     // Blocks allocated
+            size_t deallocations;   // Blocks given back
+            size_t bytesAllocated;
+            size_t bytesReleased;
+            size_t reallocations;   // Buffers replaced by a new one
+            size_t copies;          // Objects copy constructed/assigned
+            size_t moves;           // Objects moved to a new buffer
+            size_t peakCapacity;    // Largest capacity of one object
+        };
+
+
+        template <typename C>
+            Snapshot snapshot() noexcept;
+        /*
+         *  Description: Returns the counters of a container type
+         *               since the start of the program or the last
+         *               reset<C>()
+         *
+         *  Remark: All zero when ZH_INSTRUMENT is 0
+         */
+
+
+        template <typename C>
+            void reset() noexcept;
+        /*
+         *  Description: Set every counter of a container type back
+         *               to zero
+         */
+
+
+        inline void dump(std::ostream& out = std::cerr);
+        /*
+         *  Description: Print one line of counters for every
+         *               container type counted so far, in the
+         *               order the types were first counted
+         */
+
+
+        template <typename C>
+            void allocated(const C*, size_t bytes, size_t capacity) noexcept;
+        /*
+         *  Description: A container of type <C> allocated a block of
+         *               the specified size, after which it holds the
+         *               specified capacity (objects, nodes or bytes,
+         *               whatever capacity means for the container)
+         */
+
+
+        template <typename C>
+            void released(const C*, size_t bytes) noexcept;
+        /*
+         *  Description: A container of type <C> gave back a block of
+         *               the specified size
+         */
+
+
+        template <typename C>
+            void reallocated(const C*) noexcept;
+        /*
+         *  Description: A container of type <C> replaced its buffer
+         *               by a new one, the objects it copied or moved
+         *               are counted with copied() or relocated()
+         */
+
+
+        template <typename T, typename C>
+            void relocated(const C*, size_t count) noexcept;
+        /*
+         *  Description: A container of type <C> moved its objects of
+         *               type <T> to a new buffer. Counts one
+         *               reallocation, the objects as moves if <T>
+         *               moves without throwing and as copies if not,
+         *               the same choice std::move_if_noexcept makes
+         */
+
+
+        template <typename C>
+            void copied(const C*, size_t count) noexcept;
+        /*
+         *  Description: A container of type <C> copied the specified
+         *               number of objects from another one
+         */
+
+
+
+
+        //============================================||
+        //						      ||
+        // 	               Definition 		      ||
+        //					              ||
+        //============================================||
+
+
+        namespace detail{
+
+            struct Record{
+                const char* name;
+                std::atomic<Record*> next;
+
+                std::atomic<size_t> allocations;
+                std::atomic<size_t> deallocations;
+                std::atomic<size_t> bytesAllocated;
+                std::atomic<size_t> bytesReleased;
+                std::atomic<size_t> reallocations;
+                std::atomic<size_t> copies;
+                std::atomic<size_t> moves;
+                std::atomic<size_t> peakCapacity;
+
+                explicit Record(const char*) noexcept;
+            };
+
+
+            inline std::atomic<Record*>& records() noexcept{
+                static std::atomic<Record*> head(nullptr);
+                return head;
+            }
+
+
+            inline Record::Record(const char* type) noexcept: name(type),
+            next(nullptr), allocations(0), deallocations(0),
+            bytesAllocated(0), bytesReleased(0), reallocations(0),
+            copies(0), moves(0), peakCapacity(0){
+
+                // Appended at the tail so dump() keeps the order
+                // in which the types were first used
+                std::atomic<Record*>* link = &records();
+                Record* expected = nullptr;
+
+                while (!link->compare_exchange_weak(expected, this)){
+                    if (expected != nullptr){
+                        link = &expected->next;
+                        expected = nullptr;
+                    }
+                }
+            }
+
+
+            template <typename C>
+                Record& recordOf() noexcept{
+                    // One record per type, created on first use
+                    static Record record(typeid(C).name());
+                    return record;
+                }
+
+
+            inline void add(std::atomic<size_t>& counter, size_t value)
+                noexcept{
+                counter.fetch_add(value, std::memory_order_relaxed);
+            }
+
+        } // namespace detail
+
+
+        template <typename C>
+            Snapshot snapshot() noexcept{
+                Snapshot result = Snapshot();
+
+#if ZH_INSTRUMENT
+                const detail::Record& record = detail::recordOf<C>();
+
+                result.allocations = record.allocations.load();
+                result.deallocations = record.deallocations.load();
+                result.bytesAllocated = record.bytesAllocated.load();
+                result.bytesReleased = record.bytesReleased.load();
+                result.reallocations = record.reallocations.load();
+                result.copies = record.copies.load();
+                result.moves = record.moves.load();
+                result.peakCapacity = record.peakCapacity.load();
+#endif
+
+                return result;
+            }
+
+
+        template <typename C>
+            void reset() noexcept{
+#if ZH_INSTRUMENT
+                detail::Record& record = detail::recordOf<C>();
+
+                record.allocations = 0;
+                record.deallocations = 0;
+                record.bytesAllocated = 0;
+                record.bytesReleased = 0;
+                record.reallocations = 0;
+                record.copies = 0;
+                record.moves = 0;
+                record.peakCapacity = 0;
+#endif
+            }
+
+
+        inline void dump(std::ostream& out){
+#if ZH_INSTRUMENT
+            detail::Record* record = detail::records().load();
+
+            for (; record != nullptr; record = record->next.load()){
+                const char* name = record->name;
+                char* readable = nullptr;
+
+#ifdef __GNUG__
+                int status = 0;
+                readable = abi::__cxa_demangle(name, nullptr, nullptr,
+                        &status);
+
+                if (readable != nullptr){
+                    name = readable;
+                }
+#endif
+
+                out << name << ": "
+                    << record->allocations << " allocations ("
+                    << record->bytesAllocated << " bytes), "
+                    << record->deallocations << " deallocations ("
+                    << record->bytesReleased << " bytes), "
+                    << record->reallocations << " reallocations, "
+                    << record->copies << " copies, "
+                    << record->moves << " moves, peak capacity "
+                    << record->peakCapacity << '\n';
+
+                std::free(readable);
+            }
+#else
+            out << "Instrumentation is off, build with "
+                "-DZH_INSTRUMENT=1\n";
+#endif
+        }
+
+
+        template <typename C>
+            void allocated(const C*, size_t bytes, size_t capacity) noexcept{
+                detail::Record& record = detail::recordOf<C>();
+
+                detail::add(record.allocations, 1);
+                detail::add(record.bytesAllocated, bytes);
+
+                size_t peak = record.peakCapacity.load(
+                        std::memory_order_relaxed);
+
+                // On failure peak is reloaded and compared again
+                while (capacity > peak &&
+                        !record.peakCapacity.compare_exchange_weak(peak,
+                            capacity, std::memory_order_relaxed)){}
+            }
+
+
+        template <typename C>
+            void released(const C*, size_t bytes) noexcept{
+                detail::Record& record = detail::recordOf<C>();
+
+                detail::add(record.deallocations, 1);
+                detail::add(record.bytesReleased, bytes);
+            }
+
+
+        template <typename C>
+            void reallocated(const C*) noexcept{
+                detail::add(detail::recordOf<C>().reallocations, 1);
+            }
+
+
+        template <typename T, typename C>
+            void relocated(const C* owner, size_t count) noexcept{
+                detail::Record& record = detail::recordOf<C>();
+                bool moves = std::is_nothrow_move_constructible<T>::value ||
+                    !std::is_copy_constructible<T>::value;
+
+                reallocated(owner);
+                detail::add(moves ? record.moves : record.copies, count);
+            }
+
+
+        template <typename C>
+            void copied(const C*, size_t count) noexcept{
+                detail::add(detail::recordOf<C>().copies, count);
+            }
+
+    } // namespace instrument
+
+} // namespace zh
+
+#endif /* ifndef INSTRUMENT */
@@ -2,7 +2,7 @@
  * Filename:      queue.hpp
  * Version:       2.0
  * Author:        zah
- * Last Modified: 29/09/2016 
+ * Last Modified: 18/10/2026 
  *
  * Copyright © 2016 zah
  *
@@ -27,6 +27,7 @@
 #include <cstddef>
 #include <new>
 using std::bad_alloc;
+#include "instrument.hpp"
 
 
 
@@ -438,6 +439,8 @@ Queue<T>& Queue<T>::operator=(const Queue<T>& rhs){
                 // Pointer to store as current object
                 temp = new QNode(rhsPtr->data);
             }catch (bad_alloc){ throw QueueFull();}
+            ZH_COUNT(allocated(this, sizeof(QNode), rhs.counter));
+
             // Assuming our first insertion
             if (isEmpty()){
                 front = temp;
@@ -449,6 +452,7 @@ Queue<T>& Queue<T>::operator=(const Queue<T>& rhs){
             rhsPtr = rhsPtr->next;
         }
         counter = rhs.counter;
+        ZH_COUNT(copied(this, counter));
     }
     return *this;
 }
@@ -474,6 +478,8 @@ void Queue<T>::enqueue(const T& item){
         throw QueueFull();
     }
 
+    ZH_COUNT(allocated(this, sizeof(QNode), counter + 1));
+
     if (isEmpty()){ 
         front = newPtr;
         back = front;
@@ -503,6 +509,7 @@ T Queue<T>::dequeue(){
     }
 
     delete tmp;
+    ZH_COUNT(released(this, sizeof(QNode)));
     counter--;
     return val;
 }
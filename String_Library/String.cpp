@@ -1,7 +1,7 @@
 /*
  * Filename:      String.cpp
  * Author:        zah
- * Last Modified: 1/10/2016 
+ * Last Modified: 18/10/2026 
  *
  * Copyright © 2016 zah
  *
@@ -21,6 +21,7 @@
  */
 
 #include "String.h"
+#include "instrument.hpp"
 #include <cstring>
 using std::strlen;
 using std::strcpy;
@@ -34,11 +35,13 @@ String::String() throw (bad_alloc){
     strSize = 0;
     bufferSize = 10;
     buffer = new char[bufferSize];
+    ZH_COUNT(allocated(this, bufferSize, bufferSize));
     *(buffer+strSize) = '\0';
 }
 
 
 String::~String() throw(){
+    ZH_COUNT(released(this, bufferSize));
     delete [] buffer;
     buffer = 0; // We set it to zero so that even if deleted space is accessed
     // by mistake we do not cause any segmentation fault by
@@ -51,6 +54,7 @@ String::String(const char* inputCstring) throw (bad_alloc){
     strSize = strlen(inputCstring);
     bufferSize = ((strSize+1)*1.50);
     buffer = new char[bufferSize];
+    ZH_COUNT(allocated(this, bufferSize, bufferSize));
     strcpy(buffer, inputCstring);
 }
 
@@ -61,6 +65,7 @@ String::String(const char* inputCString, size_t inputSize) throw (bad_alloc){
     strSize = inputSize;
     bufferSize = ((strSize+1)*1.50);
     buffer = new char[bufferSize];
+    ZH_COUNT(allocated(this, bufferSize, bufferSize));
 
     // strncpy doesn't put a null terminating character
     // at the end of copied string
@@ -83,6 +88,7 @@ String::String(char filler, size_t inputSize) throw (bad_alloc){
     strSize = inputSize;
     bufferSize = (strSize+1)*1.50;
     buffer = new char[bufferSize];
+    ZH_COUNT(allocated(this, bufferSize, bufferSize));
 
     for (size_t i = 0; i < strSize; ++i) {
         *(buffer+i) = filler;
@@ -96,7 +102,9 @@ String::String(const String& inputString) throw (bad_alloc){
     strSize = inputString.length();
     bufferSize = (strSize+1)*1.50;
     buffer = new char[bufferSize];
+    ZH_COUNT(allocated(this, bufferSize, bufferSize));
     strcpy(buffer, inputString.buffer);
+    ZH_COUNT(copied(this, strSize));
 }
 
 
@@ -105,12 +113,15 @@ String& String::operator=(const String& rhs) throw (bad_alloc){
         strSize = rhs.length();
 
         if (strSize >= bufferSize){ // We need to reallocate
+            ZH_COUNT(released(this, bufferSize));
             bufferSize = ((strSize+1)*1.50);
             delete [] buffer;
             buffer = new char[bufferSize];
+            ZH_COUNT(allocated(this, bufferSize, bufferSize));
         }
 
         strcpy(buffer, rhs.buffer);
+        ZH_COUNT(copied(this, strSize));
     }
 
     return *this;
@@ -126,11 +137,14 @@ void String::clear() throw(){
 void String::resize(size_t newSize, char filler) throw (bad_alloc){
     if (newSize > strSize){
         if (newSize >= bufferSize){
+            ZH_COUNT(released(this, bufferSize));
             bufferSize = ((newSize+1)*1.5);
             char* newBuffer = new char[bufferSize];
+            ZH_COUNT(allocated(this, bufferSize, bufferSize));
             strcpy(newBuffer, buffer);
             delete [] buffer;
             buffer = newBuffer;
+            ZH_COUNT(relocated<char>(this, strSize));
         }
 
         for (size_t i = strSize; i < newSize; ++i) {
@@ -175,10 +189,13 @@ String& String::operator+=(const String& rhs) throw (bad_alloc){
     if((strSize+1) > bufferSize){
         // Keeping track of old buffer
         char* oldBuffer = buffer;
+        ZH_COUNT(released(this, bufferSize));
         bufferSize = (strSize+1)*1.5;
         buffer = new char[bufferSize];
+        ZH_COUNT(allocated(this, bufferSize, bufferSize));
         strcpy(buffer, oldBuffer);
         delete [] oldBuffer;
+        ZH_COUNT(relocated<char>(this, oldSize));
     }	
 
     // Custom loop to populate concatenated string onto existing buffer
@@ -246,10 +263,13 @@ istream& operator>>(istream & in, String & str) throw (bad_alloc){
     while (in.get(c)){
         if (str.strSize == str.bufferSize){
             char* oldBuffer = str.buffer;
+            ZH_COUNT(released(&str, str.bufferSize));
             str.bufferSize = (str.bufferSize+1)*1.5;
             str.buffer = new char[str.bufferSize];
+            ZH_COUNT(allocated(&str, str.bufferSize, str.bufferSize));
             strcpy(str.buffer, oldBuffer);
             delete [] oldBuffer;
+            ZH_COUNT(relocated<char>(&str, str.strSize));
         }
 
         if (isspace(c)){
@@ -274,10 +294,13 @@ istream& String::getline(istream& inStream, char delim) throw (bad_alloc){
     do{
         if (strSize == bufferSize){
             char* oldBuffer = buffer;
+            ZH_COUNT(released(this, bufferSize));
             bufferSize = (bufferSize+1)*1.5;
             buffer = new char[bufferSize];
+            ZH_COUNT(allocated(this, bufferSize, bufferSize));
             strcpy(buffer, oldBuffer);
             delete [] oldBuffer;
+            ZH_COUNT(relocated<char>(this, strSize));
         }	
 
         if (x == delim){